@@ -0,0 +1,685 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <rlfw/InjectionClient.hpp>
+#include <rlfw/rlfw.hpp>
+#include "EventPump.hpp"
+#include "PlatformEvent.hpp"
+#include "TimingWheel.hpp"
+
+// rlfw_bench drives the frame loop headlessly through the internal event pump, so no window or
+// graphics context is created. Every result is printed to stdout as one JSON object per line.
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchOptions
+    {
+        double frame_budget_ms = 1000.0 / 60.0;
+        std::size_t repetitions = 7;
+        std::size_t batch_size = 4096;
+    };
+
+    volatile std::uint64_t sSINK = 0;
+
+    constexpr std::array<std::string_view, 13> sEVENT_NAMES = {
+        "FramebufferSizeEvent",
+        "FramebufferSizeSettledEvent",
+        "ContentScaleEvent",
+        "MouseButtonEvent",
+        "MousePositionEvent",
+        "MouseCellEvent",
+        "MouseEnterEvent",
+        "MouseScrollEvent",
+        "KeyboardKeyEvent",
+        "KeyboardCharacterEvent",
+        "WindowFocusEvent",
+        "WindowIconifyEvent",
+        "WindowCloseEvent"
+    };
+
+    rl::PlatformEvent make_event(std::size_t type, std::size_t i)
+    {
+        switch (type)
+        {
+        case 0:
+            return rl::FramebufferSizeEvent{rl::cell_vector2<int>(640 + int(i % 64), 480)};
+        case 1:
+            return rl::FramebufferSizeSettledEvent{rl::cell_vector2<int>(640 + int(i % 64), 480)};
+        case 2:
+            return rl::ContentScaleEvent{rl::vector2<float>(1.0f + float(i % 2), 1.0f)};
+        case 3:
+            return rl::MouseButtonEvent{static_cast<rl::MouseButton>(i % 3), (i & 1) == 0};
+        case 4:
+            return rl::MousePositionEvent{rl::vector2<double>(double(i % 1920), double(i % 1080))};
+        case 5:
+            return rl::MouseCellEvent{rl::cell_vector2<int>(int(i % 80), int(i % 25))};
+        case 6:
+            return rl::MouseEnterEvent{(i & 1) == 0};
+        case 7:
+            return rl::MouseScrollEvent{rl::vector2<double>(0.0, (i & 1) ? 1.0 : -1.0)};
+        case 8:
+            return rl::KeyboardKeyEvent{
+                static_cast<rl::KeyboardKey>(int(rl::KeyboardKey::A) + int(i % 26)),
+                (i & 1) == 0};
+        case 9:
+            return rl::KeyboardCharacterEvent{static_cast<unsigned int>('a' + i % 26)};
+        // focus and iconify stay constant so benchmarks that follow run with a foreground window
+        case 10:
+            return rl::WindowFocusEvent{true};
+        case 11:
+            return rl::WindowIconifyEvent{false};
+        default:
+            return rl::WindowCloseEvent{};
+        }
+    }
+
+    // Window close events are left out of mixed batches because they call OnTryClose, which is
+    // measured on its own in the dispatch benchmark.
+    rl::PlatformEvent make_mixed_event(std::size_t i)
+    {
+        return make_event(i % (sEVENT_NAMES.size() - 1), i);
+    }
+
+    template<typename Body>
+    double median_ns(const BenchOptions& options, Body&& body)
+    {
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        for (std::size_t r = 0; r < options.repetitions; r++)
+        {
+            samples.push_back(body());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    double elapsed_ns(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    void report(std::string_view benchmark,
+                std::string_view variant,
+                std::size_t operations,
+                double ns_per_op)
+    {
+        std::printf(
+            "{\"benchmark\":\"%.*s\",\"case\":\"%.*s\",\"operations\":%zu,"
+            "\"ns_per_op\":%.3f,\"ops_per_second\":%.0f}\n",
+            int(benchmark.size()),
+            benchmark.data(),
+            int(variant.size()),
+            variant.data(),
+            operations,
+            ns_per_op,
+            ns_per_op > 0.0 ? 1e9 / ns_per_op : 0.0);
+    }
+
+    void bench_enqueue(const BenchOptions& options)
+    {
+        const auto n = options.batch_size;
+        // warm the queue so the measurement does not include its first growth
+        for (std::size_t i = 0; i < n; i++) rl::push_event(make_mixed_event(i));
+        rl::dispatch_events();
+        const auto ns = median_ns(
+            options,
+            [&]
+            {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < n; i++) rl::push_event(make_mixed_event(i));
+                const auto total = elapsed_ns(start);
+                rl::dispatch_events();
+                return total / double(n);
+            });
+        report("enqueue", "mixed", n, ns);
+    }
+
+    void bench_dispatch(const BenchOptions& options)
+    {
+        const auto n = options.batch_size;
+        for (std::size_t type = 0; type < sEVENT_NAMES.size(); type++)
+        {
+            const auto ns = median_ns(
+                options,
+                [&]
+                {
+                    for (std::size_t i = 0; i < n; i++) rl::push_event(make_event(type, i));
+                    const auto start = Clock::now();
+                    sSINK = sSINK + rl::dispatch_events();
+                    return elapsed_ns(start) / double(n);
+                });
+            report("dispatch", sEVENT_NAMES[type], n, ns);
+        }
+    }
+
+    struct OverlayLayer : public rl::App
+    {
+        void OnMousePosition(const rl::vector2<double>& position) override
+        {
+            sSINK = sSINK + 1;
+        }
+    };
+
+    // Dispatches mouse motion through four overlay layers above the app, once with the overlays
+    // subscribed to everything and once with them masked to keyboard input, as a text prompt or
+    // menu layer would be.
+    void bench_layers(const BenchOptions& options)
+    {
+        constexpr std::size_t overlay_count = 4;
+        std::array<OverlayLayer, overlay_count> overlays;
+        const std::array<std::pair<std::string_view, rl::EventMask>, 2> cases = {
+            std::pair<std::string_view, rl::EventMask>("all", rl::EventMask::All),
+            std::pair<std::string_view, rl::EventMask>("keyboard_masked", rl::EventMask::Keyboard)};
+        const auto n = options.batch_size;
+        for (const auto& [name, events] : cases)
+        {
+            for (auto& overlay : overlays) rl::push_layer(overlay, events);
+            const auto ns = median_ns(
+                options,
+                [&]
+                {
+                    for (std::size_t i = 0; i < n; i++)
+                    {
+                        rl::push_event(
+                            rl::MousePositionEvent{rl::vector2<double>(double(i % 1920), 0.0)});
+                    }
+                    const auto start = Clock::now();
+                    sSINK = sSINK + rl::dispatch_events();
+                    return elapsed_ns(start) / double(n);
+                });
+            report("layers", name, n, ns);
+            for (std::size_t i = 0; i < overlay_count; i++) rl::pop_layer();
+        }
+    }
+
+    struct HoverLayer : public rl::App
+    {
+        void OnMouseCell(const rl::cell_vector2<int>& cell) override
+        {
+            sSINK = sSINK + 1;
+        }
+    };
+
+    // Sweeps the cursor across a 16 by 16 pixel tile grid in quarter pixel steps, so most
+    // position events stay within the hovered cell and only the transitions reach OnMouseCell.
+    void bench_mouse_cell(const BenchOptions& options)
+    {
+        HoverLayer hover;
+        rl::push_layer(hover, rl::EventMask::MouseCell);
+        rl::set_mouse_cell_size(rl::cell_vector2<int>(16, 16));
+        const auto n = options.batch_size;
+        const auto ns = median_ns(
+            options,
+            [&]
+            {
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    rl::push_event(
+                        rl::MousePositionEvent{rl::vector2<double>(double(i) * 0.25, 8.0)});
+                }
+                const auto start = Clock::now();
+                sSINK = sSINK + rl::dispatch_events();
+                return elapsed_ns(start) / double(n);
+            });
+        report("mouse_cell", "quarter_pixel_sweep", n, ns);
+        rl::set_mouse_cell_size(rl::cell_vector2<int>(1, 1));
+        rl::pop_layer();
+    }
+
+    // Pushes a batch of key events through a shared memory injection channel, as a bot process
+    // would, and then runs one frame that merges and dispatches them. Both ends live in this
+    // process, so the numbers leave out only the cross core transfer of the ring.
+    void bench_injection(const BenchOptions& options)
+    {
+        const auto channel =
+            "rlfw_bench_" + std::to_string(Clock::now().time_since_epoch().count());
+        rl::set_input_injection_channel(channel);
+        rl::InjectionClient client(channel);
+        const auto n = std::min<std::size_t>(options.batch_size, client.get_free_capacity());
+        const auto push_batch = [&]
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                client.push_keyboard_key(
+                    static_cast<rl::KeyboardKey>(int(rl::KeyboardKey::A) + int(i % 26)),
+                    (i & 1) == 0);
+            }
+        };
+        const auto push_ns = median_ns(
+            options,
+            [&]
+            {
+                const auto start = Clock::now();
+                push_batch();
+                const auto total = elapsed_ns(start);
+                sSINK = sSINK + rl::run_frame();
+                return total / double(n);
+            });
+        report("injection", "push", n, push_ns);
+        const auto frame_ns = median_ns(
+            options,
+            [&]
+            {
+                push_batch();
+                const auto start = Clock::now();
+                sSINK = sSINK + rl::run_frame();
+                return elapsed_ns(start) / double(n);
+            });
+        report("injection", "merge_and_dispatch", n, frame_ns);
+        rl::set_input_injection_channel("");
+    }
+
+    struct SimulationApp : public rl::App
+    {
+        std::size_t frame_count = 0;
+        std::size_t frame_limit = 0;
+
+        void OnKeyboardKey(rl::KeyboardKey key, bool pressed) override
+        {
+            sSINK = sSINK + pressed;
+        }
+
+        void OnUpdate() override
+        {
+            rl::push_event(rl::KeyboardKeyEvent{rl::KeyboardKey::Space, (frame_count & 1) == 0});
+            if (++frame_count == frame_limit)
+            {
+                rl::try_close();
+            }
+        }
+    };
+
+    // Runs a few hundred headless instances that each feed themselves one key event per frame,
+    // once on a single thread and once on every hardware thread, and reports the cost of one
+    // instance frame.
+    void bench_headless(const BenchOptions& options)
+    {
+        constexpr std::size_t instance_count = 256;
+        constexpr std::size_t frame_limit = 256;
+        std::vector<std::size_t> thread_counts = {1};
+        if (std::thread::hardware_concurrency() > 1)
+        {
+            thread_counts.push_back(std::thread::hardware_concurrency());
+        }
+        for (const auto thread_count : thread_counts)
+        {
+            const auto ns = median_ns(
+                options,
+                [&]
+                {
+                    std::vector<SimulationApp> apps(instance_count);
+                    std::vector<rl::App*> app_pointers;
+                    for (auto& app : apps)
+                    {
+                        app.frame_limit = frame_limit;
+                        app_pointers.push_back(&app);
+                    }
+                    const auto start = Clock::now();
+                    rl::run_headless(app_pointers, thread_count);
+                    return elapsed_ns(start) / double(instance_count * frame_limit);
+                });
+            report("headless",
+                   "threads_" + std::to_string(thread_count),
+                   instance_count * frame_limit,
+                   ns);
+        }
+    }
+
+    // A deterministic play session: typing bursts, held movement keys, occasional clicks, a cursor
+    // that drifts most frames and an occasional scroll notch.
+    std::vector<rl::InputSnapshot> make_input_session(std::size_t frame_count)
+    {
+        std::vector<rl::InputSnapshot> session;
+        session.reserve(frame_count);
+        rl::InputSnapshot snapshot;
+        std::uint32_t seed = 12345;
+        const auto next = [&]
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return seed >> 8;
+        };
+        for (std::size_t frame = 0; frame < frame_count; frame++)
+        {
+            snapshot.frame = frame;
+            if (next() % 6 == 0)
+            {
+                snapshot.keyboard_keys.flip(
+                    static_cast<std::size_t>(rl::KeyboardKey::A) - 1 + next() % 26);
+            }
+            if (next() % 40 == 0)
+            {
+                snapshot.mouse_buttons.flip(next() % 2);
+            }
+            if (next() % 3 != 0)
+            {
+                snapshot.mouse_position.x += double(int(next() % 9) - 4) * 1.5;
+                snapshot.mouse_position.y += double(int(next() % 5) - 2) * 1.5;
+            }
+            snapshot.mouse_scroll =
+                rl::vector2<double>(0.0, next() % 30 == 0 ? (next() % 2 ? 1.0 : -1.0) : 0.0);
+            session.push_back(snapshot);
+        }
+        return session;
+    }
+
+    // Encodes and decodes a session of per frame input deltas, and reports the stream size next
+    // to the size of the raw input state each frame would otherwise send.
+    void bench_input_delta(const BenchOptions& options)
+    {
+        const auto session = make_input_session(options.batch_size);
+        std::vector<std::uint8_t> bytes;
+        bytes.reserve(session.size() * 16);
+        const auto encode_ns = median_ns(
+            options,
+            [&]
+            {
+                rl::InputDeltaEncoder encoder;
+                bytes.clear();
+                const auto start = Clock::now();
+                for (const auto& snapshot : session) encoder.encode(snapshot, bytes);
+                return elapsed_ns(start) / double(session.size());
+            });
+        report("input_delta", "encode", session.size(), encode_ns);
+        const auto decode_ns = median_ns(
+            options,
+            [&]
+            {
+                rl::InputDeltaDecoder decoder;
+                std::span<const std::uint8_t> remaining = bytes;
+                double total = 0.0;
+                // decoded events are dispatched a frame's worth at a time, outside the timing
+                while (!remaining.empty())
+                {
+                    const auto start = Clock::now();
+                    remaining = remaining.subspan(decoder.decode(remaining));
+                    total += elapsed_ns(start);
+                    rl::dispatch_events();
+                }
+                return total / double(session.size());
+            });
+        report("input_delta", "decode", session.size(), decode_ns);
+        // the decoded state must match every encoded frame, up to the cursor quantization
+        rl::InputDeltaDecoder decoder;
+        std::span<const std::uint8_t> remaining = bytes;
+        for (const auto& snapshot : session)
+        {
+            remaining = remaining.subspan(decoder.decode(remaining));
+            rl::dispatch_events();
+            const auto& state = decoder.get_state();
+            const auto step = rl::InputDeltaSettings().mouse_position_step;
+            const bool matches =
+                state.keyboard_keys == snapshot.keyboard_keys &&
+                state.mouse_buttons == snapshot.mouse_buttons &&
+                state.mouse_position.x == std::round(snapshot.mouse_position.x / step) * step &&
+                state.mouse_position.y == std::round(snapshot.mouse_position.y / step) * step &&
+                state.mouse_scroll.x == snapshot.mouse_scroll.x &&
+                state.mouse_scroll.y == snapshot.mouse_scroll.y;
+            if (!matches)
+            {
+                throw std::runtime_error("input delta round trip mismatch in frame " +
+                                         std::to_string(snapshot.frame));
+            }
+        }
+        // key bits, button bits, then the cursor position and scroll as doubles
+        constexpr std::size_t raw_bytes_per_frame =
+            (348 + 7) / 8 + 1 + 2 * sizeof(rl::vector2<double>);
+        std::printf(
+            "{\"benchmark\":\"input_delta\",\"case\":\"stream_size\",\"frames\":%zu,"
+            "\"bytes_per_frame\":%.3f,\"raw_bytes_per_frame\":%zu}\n",
+            session.size(),
+            double(bytes.size()) / double(session.size()),
+            raw_bytes_per_frame);
+    }
+
+    // Drops a batch of paths per frame, the way dragging a folder of save files onto the window
+    // would, and measures enqueue plus dispatch per path once the event arena has warmed up.
+    void bench_file_drop(const BenchOptions& options)
+    {
+        constexpr std::size_t path_count = 256;
+        std::vector<std::string> paths;
+        std::vector<const char*> path_pointers;
+        for (std::size_t i = 0; i < path_count; i++)
+        {
+            paths.push_back("/home/player/.local/share/rlfw/saves/slot_" + std::to_string(i) +
+                            ".sav");
+        }
+        for (const auto& path : paths) path_pointers.push_back(path.c_str());
+        const auto n = std::max<std::size_t>(1, options.batch_size / path_count);
+        rl::push_file_drop_event(int(path_count), path_pointers.data());
+        rl::dispatch_events();
+        const auto ns = median_ns(
+            options,
+            [&]
+            {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    rl::push_file_drop_event(int(path_count), path_pointers.data());
+                    rl::dispatch_events();
+                }
+                return elapsed_ns(start) / double(n * path_count);
+            });
+        report("file_drop", "per_path", n * path_count, ns);
+    }
+
+    void bench_frame(const BenchOptions& options)
+    {
+        const auto frames = options.batch_size * 16;
+        const auto ns = median_ns(
+            options,
+            [&]
+            {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < frames; i++) sSINK = sSINK + rl::run_frame();
+                return elapsed_ns(start) / double(frames);
+            });
+        report("frame", "empty_app", frames, ns);
+    }
+
+    // Schedules thousands of status effect style timers, cancels half of them and then advances
+    // the wheel one 16 ms frame at a time, which is the per frame work rl::run does for timers.
+    void bench_timers(const BenchOptions& options)
+    {
+        const auto n = options.batch_size * 4;
+        std::vector<rl::TimerId> timers(n);
+        std::uint64_t fired = 0;
+        double schedule_ns = 0.0;
+        double cancel_ns = 0.0;
+        const auto frames = 600;
+        const auto frame_ns = median_ns(
+            options,
+            [&]
+            {
+                rl::TimingWheel wheel;
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    timers[i] = wheel.schedule((i * 7919) % 10000 + 1, 0, [&fired] { fired++; });
+                }
+                schedule_ns = elapsed_ns(start) / double(n);
+                start = Clock::now();
+                for (std::size_t i = 0; i < n; i += 2) wheel.cancel(timers[i]);
+                cancel_ns = elapsed_ns(start) / double(n / 2);
+                start = Clock::now();
+                for (int frame = 1; frame <= frames; frame++) wheel.advance(frame * 16);
+                return elapsed_ns(start) / double(frames);
+            });
+        sSINK = sSINK + fired;
+        report("timers", "schedule", n, schedule_ns);
+        report("timers", "cancel", n / 2, cancel_ns);
+        report("timers", "advance_frame", frames, frame_ns);
+    }
+
+    template<typename Query>
+    void bench_query(const BenchOptions& options, std::string_view name, Query&& query)
+    {
+        const auto n = options.batch_size * 64;
+        const auto ns = median_ns(
+            options,
+            [&]
+            {
+                std::uint64_t hits = 0;
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < n; i++) hits += query(i);
+                const auto total = elapsed_ns(start);
+                sSINK = sSINK + hits;
+                return total / double(n);
+            });
+        report("query", name, n, ns);
+    }
+
+    void bench_queries(const BenchOptions& options)
+    {
+        rl::push_event(rl::KeyboardKeyEvent{rl::KeyboardKey::LeftControl, true});
+        rl::push_event(rl::KeyboardKeyEvent{rl::KeyboardKey::W, true});
+        rl::push_event(rl::MouseButtonEvent{rl::MouseButton::Left, true});
+        rl::dispatch_events();
+        bench_query(options,
+                    "get_pressed_key",
+                    [](std::size_t i)
+                    {
+                        return rl::get_pressed(
+                            static_cast<rl::KeyboardKey>(int(rl::KeyboardKey::A) + int(i % 26)));
+                    });
+        bench_query(options,
+                    "get_pressed_mouse_button",
+                    [](std::size_t i)
+                    { return rl::get_pressed(static_cast<rl::MouseButton>(i % 8)); });
+        bench_query(options, "get_ctrl_pressed", [](std::size_t) { return rl::get_ctrl_pressed(); });
+        bench_query(options, "get_shift_pressed", [](std::size_t) { return rl::get_shift_pressed(); });
+        bench_query(options,
+                    "get_input_snapshot",
+                    [](std::size_t) { return rl::get_input_snapshot().ctrl_pressed; });
+    }
+
+    double storm_frame_ns(const BenchOptions& options, std::size_t events_per_frame)
+    {
+        return median_ns(
+            options,
+            [&]
+            {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < events_per_frame; i++)
+                {
+                    rl::push_event(make_mixed_event(i));
+                }
+                sSINK = sSINK + rl::run_frame();
+                return elapsed_ns(start);
+            });
+    }
+
+    // Finds the largest number of events per frame that enqueue and a full frame can absorb
+    // within the frame budget, by doubling and then bisecting the event count.
+    void bench_event_storm(const BenchOptions& options)
+    {
+        constexpr std::size_t max_events_per_frame = std::size_t(1) << 22;
+        const double budget_ns = options.frame_budget_ms * 1e6;
+        std::size_t low = 0;
+        std::size_t high = 64;
+        while (high <= max_events_per_frame && storm_frame_ns(options, high) <= budget_ns)
+        {
+            low = high;
+            high *= 2;
+        }
+        const bool capped = high > max_events_per_frame;
+        while (!capped && high - low > std::max<std::size_t>(1, low / 64))
+        {
+            const auto middle = low + (high - low) / 2;
+            if (storm_frame_ns(options, middle) <= budget_ns)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        const auto frame_ns = low > 0 ? storm_frame_ns(options, low) : 0.0;
+        std::printf(
+            "{\"benchmark\":\"event_storm\",\"case\":\"mixed\",\"frame_budget_ms\":%.3f,"
+            "\"max_events_per_frame\":%zu,\"frame_ns\":%.0f,\"max_events_per_second\":%.0f,"
+            "\"capped\":%s}\n",
+            options.frame_budget_ms,
+            low,
+            frame_ns,
+            double(low) * 1000.0 / options.frame_budget_ms,
+            capped ? "true" : "false");
+    }
+
+    BenchOptions parse_options(int argc, char** argv)
+    {
+        BenchOptions options;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string_view name = argv[i];
+            if (name == "--budget-ms")
+            {
+                options.frame_budget_ms = std::strtod(argv[i + 1], nullptr);
+            }
+            else if (name == "--repetitions")
+            {
+                options.repetitions = std::max(1ul, std::strtoul(argv[i + 1], nullptr, 10));
+            }
+            else if (name == "--batch")
+            {
+                options.batch_size = std::max(1ul, std::strtoul(argv[i + 1], nullptr, 10));
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parse_options(argc, argv);
+    rl::App app;
+    rl::push_layer(app);
+    bench_enqueue(options);
+    bench_dispatch(options);
+    bench_layers(options);
+    bench_mouse_cell(options);
+    bench_injection(options);
+    bench_headless(options);
+    bench_input_delta(options);
+    bench_file_drop(options);
+    bench_frame(options);
+    bench_queries(options);
+    bench_timers(options);
+    bench_event_storm(options);
+}
@@ -27,6 +27,8 @@
 #include <rlfw/KeyboardKey.hpp>
 #include <rlm/cellular/cell_vector2.hpp>
 #include <rlm/linear/vector2.hpp>
+#include <span>
+#include <string_view>
 
 namespace rl
 {
@@ -34,15 +36,26 @@ namespace rl
     {
     public:
         virtual void OnAppStart();
+        // Called after OnAppStart on a worker thread, while the window and its context are being
+        // created, to read or decode resources ahead of OnLoadResources, which waits for it. It
+        // must not call rl:: functions or use the context.
+        virtual void OnPrefetchResources();
         virtual void OnLoadResources();
         virtual void OnFrameStart();
         virtual void OnFramebufferSize(const rl::cell_vector2<int>& size);
+        virtual void OnFramebufferSizeSettled(const rl::cell_vector2<int>& size);
+        virtual void OnContentScale(const rl::vector2<float>& scale);
         virtual void OnMouseButton(rl::MouseButton button, bool pressed);
         virtual void OnMousePosition(const rl::vector2<double>& position);
+        virtual void OnMouseCell(const rl::cell_vector2<int>& cell);
         virtual void OnMouseEnter(bool entered);
         virtual void OnMouseScroll(const rl::vector2<double>& translation);
         virtual void OnKeyboardKey(rl::KeyboardKey key, bool pressed);
         virtual void OnKeyboardCharacter(unsigned int codepoint);
+        virtual void OnFileDrop(std::span<const std::string_view> paths);
+        virtual void OnClipboardPaste(std::string_view text);
+        virtual void OnWindowFocus(bool focused);
+        virtual void OnWindowIconify(bool iconified);
         virtual bool OnTryClose();
         virtual void OnUpdate();
         virtual void OnPostDraw();
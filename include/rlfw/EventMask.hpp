@@ -0,0 +1,67 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace rl
+{
+    // Selects the App event handlers a layer is dispatched to. Handlers a layer leaves out are
+    // never called for it, so layers that only care about a few events cost nothing for the rest.
+    enum class EventMask : std::uint32_t
+    {
+        None                    = 0,
+        FramebufferSize         = 1u << 0,
+        FramebufferSizeSettled  = 1u << 1,
+        ContentScale            = 1u << 2,
+        MouseButton             = 1u << 3,
+        MousePosition           = 1u << 4,
+        MouseCell               = 1u << 5,
+        MouseEnter              = 1u << 6,
+        MouseScroll             = 1u << 7,
+        KeyboardKey             = 1u << 8,
+        KeyboardCharacter       = 1u << 9,
+        FileDrop                = 1u << 10,
+        ClipboardPaste          = 1u << 11,
+        WindowFocus             = 1u << 12,
+        WindowIconify           = 1u << 13,
+        TryClose                = 1u << 14,
+        Mouse                   = MouseButton | MousePosition | MouseCell | MouseEnter |
+                                  MouseScroll,
+        Keyboard                = KeyboardKey | KeyboardCharacter,
+        All                     = 0xFFFFFFFFu
+    };
+
+    constexpr rl::EventMask operator|(rl::EventMask a, rl::EventMask b) noexcept
+    {
+        return static_cast<rl::EventMask>(static_cast<std::uint32_t>(a) |
+                                          static_cast<std::uint32_t>(b));
+    }
+
+    constexpr rl::EventMask operator&(rl::EventMask a, rl::EventMask b) noexcept
+    {
+        return static_cast<rl::EventMask>(static_cast<std::uint32_t>(a) &
+                                          static_cast<std::uint32_t>(b));
+    }
+}
@@ -0,0 +1,81 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rl
+{
+    // The parts of a frame of the loop, in the order they run. Frame hooks, event handlers, timer
+    // callbacks and tasks run in the phase of the step that calls them.
+    enum class FramePhase : std::uint8_t
+    {
+        None,
+        FrameStart,
+        Poll,
+        Dispatch,
+        Timers,
+        Tasks,
+        Update,
+        Draw
+    };
+
+    constexpr std::size_t frame_phase_count = 8;
+
+    // Heap activity of the thread running the loop during the last completed frame. The counts
+    // are only collected when rlfw is built with RLFW_ALLOCATION_TRACKING, and are zero otherwise.
+    struct FrameStats
+    {
+        std::uint64_t frame = 0;
+        std::uint64_t allocation_count = 0;
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t deallocation_count = 0;
+        // allocations made in a phase marked hot with rl::set_hot_phase()
+        std::uint64_t hot_allocation_count = 0;
+        std::array<std::uint64_t, rl::frame_phase_count> phase_allocation_counts = {};
+        std::array<std::uint64_t, rl::frame_phase_count> phase_allocated_bytes = {};
+    };
+
+    struct AllocationReport
+    {
+        rl::FramePhase phase = rl::FramePhase::None;
+        std::size_t size = 0;
+        // the return address of the replaced operator new, or nullptr where it is not available
+        const void* call_site = nullptr;
+    };
+
+    // Called on the allocating thread, with allocations inside it neither tracked nor reported.
+    using AllocationHandler = void (*)(const rl::AllocationReport& report);
+
+    const char* get_frame_phase_name(rl::FramePhase phase) noexcept;
+    const rl::FrameStats& get_frame_stats() noexcept;
+    // Every allocation in a hot phase is passed to the allocation handler. The default handler
+    // prints the size, phase and call stack to stderr, and a CI build can install one that aborts.
+    void set_hot_phase(rl::FramePhase phase, bool hot) noexcept;
+    bool get_hot_phase(rl::FramePhase phase) noexcept;
+    // Passing nullptr restores the default handler.
+    void set_allocation_handler(rl::AllocationHandler handler) noexcept;
+}
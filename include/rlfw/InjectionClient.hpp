@@ -0,0 +1,70 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <rlfw/KeyboardKey.hpp>
+#include <rlfw/MouseButton.hpp>
+#include <rlm/cellular/cell_vector2.hpp>
+#include <rlm/linear/vector2.hpp>
+
+namespace rl
+{
+    struct InjectionRing;
+
+    // Writes input events into the injection channel an rlfw app opened with
+    // rl::set_input_injection_channel(). It is provided by the rlfw::inject library, which has no
+    // window system dependency. Only one client may write to a channel at a time. The push
+    // functions return false without blocking when the ring is full, which happens when the app
+    // has not run a frame since it last filled up. They throw for keys and buttons the app could
+    // not represent, which the app would drop anyway.
+    class InjectionClient
+    {
+    public:
+        explicit InjectionClient(std::string_view channel);
+        ~InjectionClient();
+        InjectionClient(const InjectionClient&) = delete;
+        InjectionClient& operator=(const InjectionClient&) = delete;
+
+        bool push_keyboard_key(rl::KeyboardKey key, bool pressed);
+        bool push_keyboard_character(unsigned int codepoint);
+        bool push_mouse_button(rl::MouseButton button, bool pressed);
+        bool push_mouse_position(const rl::vector2<double>& position);
+        bool push_mouse_cell(const rl::cell_vector2<int>& cell);
+        bool push_mouse_scroll(const rl::vector2<double>& translation);
+        bool push_try_close();
+        std::size_t get_free_capacity() noexcept;
+
+    private:
+        template<typename Event>
+        bool push(const Event& event);
+
+        rl::InjectionRing* ring = nullptr;
+        std::uint64_t head = 0;
+        std::uint64_t cached_tail = 0;
+    };
+}
@@ -0,0 +1,91 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <rlfw/InputSnapshot.hpp>
+#include <rlm/linear/vector2.hpp>
+
+namespace rl
+{
+    // Cursor coordinates and scroll are sent as whole multiples of these steps, so both peers of
+    // a lockstep session see exactly the same values. They are clamped to 2^40 steps either side
+    // of zero, and NaN is sent as zero.
+    struct InputDeltaSettings
+    {
+        double mouse_position_step = 1.0;
+        double mouse_scroll_step = 1.0 / 16.0;
+    };
+
+    // Encodes the input of one frame after another as compact deltas for lockstep networking.
+    // A frame with no input change is a single byte. Each frame holds a flags byte, then the
+    // keys that changed as varint gaps between their indices, the changed mouse buttons as a
+    // mask byte, the cursor movement as zigzag varints of quantized steps, and the frame's
+    // scroll as zigzag varints. Frames must be decoded in the order they were encoded, by a
+    // decoder with the same settings.
+    class InputDeltaEncoder
+    {
+    public:
+        explicit InputDeltaEncoder(
+            const rl::InputDeltaSettings& settings = rl::InputDeltaSettings());
+
+        // Appends the delta from the previously encoded frame and returns its size in bytes.
+        std::size_t encode(const rl::InputSnapshot& snapshot, std::vector<std::uint8_t>& bytes);
+        // Forgets the previous frame, as for a new session.
+        void reset() noexcept;
+
+    private:
+        rl::InputDeltaSettings settings;
+        std::bitset<348> keyboard_keys;
+        std::bitset<8> mouse_buttons;
+        std::int64_t mouse_x = 0;
+        std::int64_t mouse_y = 0;
+    };
+
+    class InputDeltaDecoder
+    {
+    public:
+        explicit InputDeltaDecoder(
+            const rl::InputDeltaSettings& settings = rl::InputDeltaSettings());
+
+        // Decodes one frame from the front of bytes, applies it to the rebuilt state and pushes
+        // the matching key, mouse button, cursor and scroll events to the running loop, to be
+        // dispatched on its next frame. Returns the number of bytes read. Throws
+        // std::runtime_error on truncated or malformed input, leaving the state unchanged.
+        std::size_t decode(std::span<const std::uint8_t> bytes);
+        // The input state as of the last decoded frame.
+        const rl::InputSnapshot& get_state() const noexcept;
+        void reset() noexcept;
+
+    private:
+        rl::InputDeltaSettings settings;
+        rl::InputSnapshot state;
+        std::int64_t mouse_x = 0;
+        std::int64_t mouse_y = 0;
+    };
+}
@@ -0,0 +1,58 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <rlfw/KeyboardKey.hpp>
+#include <rlfw/MouseButton.hpp>
+#include <rlm/cellular/cell_vector2.hpp>
+#include <rlm/linear/vector2.hpp>
+
+namespace rl
+{
+    // An immutable copy of the input state, published by the main loop once per frame after
+    // events are processed. Snapshots can be read from any thread with rl::get_input_snapshot().
+    struct InputSnapshot
+    {
+        std::uint64_t frame = 0;
+        std::bitset<348> keyboard_keys;
+        std::bitset<8> mouse_buttons;
+        rl::vector2<double> mouse_position = rl::vector2<double>();
+        // empty until the cursor position is first known
+        std::optional<rl::cell_vector2<int>> mouse_cell;
+        // the scroll translation accumulated over the frame
+        rl::vector2<double> mouse_scroll = rl::vector2<double>();
+        rl::cell_vector2<int> window_size = rl::cell_vector2<int>();
+        bool mouse_entered = false;
+        bool ctrl_pressed = false;
+        bool alt_pressed = false;
+        bool shift_pressed = false;
+        bool super_pressed = false;
+
+        bool get_pressed(rl::MouseButton button) const;
+        bool get_pressed(rl::KeyboardKey key) const;
+    };
+}
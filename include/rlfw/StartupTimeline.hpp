@@ -0,0 +1,67 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace rl
+{
+    // The stages of rl::run() up to the first frame, in the order they start. Prefetch runs
+    // OnPrefetchResources on a worker thread alongside PlatformInit and WindowCreation, and
+    // PrefetchWait is the time the main thread then spends waiting for it to finish.
+    enum class StartupStage : std::uint8_t
+    {
+        AppStart,
+        Prefetch,
+        PlatformInit,
+        WindowCreation,
+        PrefetchWait,
+        LoadResources,
+        CallbackSetup,
+        FirstFrame
+    };
+
+    constexpr std::size_t startup_stage_count = 8;
+
+    // Where the time to the first frame of rl::run() went. Times are offsets from the start of
+    // rl::run(), and stay zero for stages that have not run. The timeline of the last run is kept
+    // after it returns, until the next one starts.
+    struct StartupTimeline
+    {
+        std::array<std::chrono::nanoseconds, rl::startup_stage_count> stage_begin = {};
+        std::array<std::chrono::nanoseconds, rl::startup_stage_count> stage_end = {};
+        // when the first frame was done and the window shown, if that has happened yet
+        std::chrono::nanoseconds time_to_first_frame = std::chrono::nanoseconds(0);
+        bool complete = false;
+    };
+
+    const char* get_startup_stage_name(rl::StartupStage stage) noexcept;
+    const rl::StartupTimeline& get_startup_timeline() noexcept;
+    // Writes each stage's start and duration in milliseconds, one per line.
+    void dump_startup_timeline(std::ostream& stream);
+}
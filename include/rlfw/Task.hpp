@@ -0,0 +1,105 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <rlfw/KeyboardKey.hpp>
+
+namespace rl
+{
+    // A fire and forget coroutine driven by the main loop. Start one with rl::spawn(); it runs
+    // until its first co_await and is then resumed by rl::run once the awaited condition fires.
+    // Tasks must only be spawned and awaited on the thread running the loop. Frames come from a
+    // pooled allocator, so spawning tasks in steady state does not touch the heap.
+    class Task
+    {
+    public:
+        class promise_type
+        {
+        public:
+            Task get_return_object() noexcept;
+            std::suspend_always initial_suspend() noexcept;
+            std::suspend_never final_suspend() noexcept;
+            void return_void() noexcept;
+            void unhandled_exception();
+            static void* operator new(std::size_t size);
+            static void operator delete(void* pointer, std::size_t size) noexcept;
+        };
+
+        Task(Task&& other) noexcept;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task& operator=(Task&&) = delete;
+        ~Task();
+
+    private:
+        friend void spawn(rl::Task task);
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    class NextFrameAwaiter
+    {
+    public:
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept;
+    };
+
+    class KeyPressedAwaiter
+    {
+    public:
+        explicit KeyPressedAwaiter(rl::KeyboardKey key) noexcept;
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept;
+
+        // intrusive links of the per key wait list, owned by the scheduler while suspended
+        rl::KeyboardKey key;
+        std::coroutine_handle<> handle;
+        KeyPressedAwaiter* next = nullptr;
+    };
+
+    class DelayAwaiter
+    {
+    public:
+        explicit DelayAwaiter(std::chrono::nanoseconds duration) noexcept;
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept;
+
+        // intrusive links of the scheduler's delayed list, so suspended delays can be destroyed
+        std::chrono::nanoseconds duration;
+        std::coroutine_handle<> handle;
+        DelayAwaiter* previous = nullptr;
+        DelayAwaiter* next = nullptr;
+    };
+
+    void spawn(rl::Task task);
+    rl::NextFrameAwaiter next_frame() noexcept;
+    rl::KeyPressedAwaiter key_pressed(rl::KeyboardKey key) noexcept;
+    rl::DelayAwaiter delay(std::chrono::nanoseconds duration) noexcept;
+}
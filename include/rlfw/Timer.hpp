@@ -0,0 +1,54 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace rl
+{
+    // Identifies a scheduled timer. A default constructed id refers to no timer, and ids of
+    // timers that already fired or were cancelled are never reused.
+    struct TimerId
+    {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0;
+    };
+
+    using ClockFunction = std::chrono::steady_clock::time_point (*)();
+
+    // Timers are owned by the running loop and fire in a batch once per frame, before tasks are
+    // resumed and before OnUpdate. Scheduling and cancelling are constant time and must happen on
+    // the thread running the loop. The resolution is one millisecond.
+    rl::TimerId schedule_timer(std::chrono::nanoseconds delay, std::function<void()> callback);
+    rl::TimerId schedule_repeating_timer(std::chrono::nanoseconds interval,
+                                         std::function<void()> callback);
+    bool cancel_timer(rl::TimerId timer);
+    // Replaces the clock timers and delays are measured with, so they can be driven
+    // deterministically by tests and replays. Passing nullptr restores std::chrono::steady_clock.
+    // Timers already scheduled keep their remaining time across the switch.
+    void set_clock(rl::ClockFunction clock);
+    std::chrono::steady_clock::time_point get_time();
+}
@@ -0,0 +1,71 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include <rlfw/EventMask.hpp>
+#include <rlfw/FrameStats.hpp>
+
+namespace rl
+{
+    // Controls the hitch watchdog, a thread that watches the main loop's progress through the
+    // phases of each frame and records frames that run over budget while they are still stuck.
+    // Time the loop spends waiting on purpose, for the background policy or an idle loop, does
+    // not count against the budget.
+    struct WatchdogSettings
+    {
+        bool enabled = false;
+        std::chrono::milliseconds frame_budget = std::chrono::milliseconds(100);
+        // Interrupts the loop thread to sample its call stack when a hitch is first seen.
+        // Only supported on Linux, and uses the SIGURG signal.
+        bool sample_stack = false;
+        // The number of most recent records kept.
+        std::size_t record_capacity = 64;
+    };
+
+    struct HitchRecord
+    {
+        std::uint64_t frame = 0;
+        // where the frame was when last observed, and for how long it had been there
+        rl::FramePhase phase = rl::FramePhase::None;
+        // the event whose handlers were running, if the phase is Dispatch
+        rl::EventMask event = rl::EventMask::None;
+        std::chrono::nanoseconds phase_time = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds frame_time = std::chrono::nanoseconds(0);
+        std::array<void*, 32> stack = {};
+        std::uint32_t stack_depth = 0;
+    };
+
+    void set_watchdog_settings(const rl::WatchdogSettings& settings);
+    const rl::WatchdogSettings& get_watchdog_settings();
+    // Returns the recorded hitches, oldest first.
+    std::vector<rl::HitchRecord> get_hitch_records();
+    void clear_hitch_records();
+    // Writes the recorded hitches in a readable form, with symbolized stacks where possible.
+    void dump_hitch_records(std::ostream& stream);
+}
@@ -23,32 +23,93 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <rlm/cellular/cell_vector2.hpp>
+#include <rlm/linear/vector2.hpp>
 #include <string>
 #include <rlfw/App.hpp>
+#include <rlfw/BackgroundPolicy.hpp>
+#include <rlfw/EventMask.hpp>
+#include <rlfw/FrameStats.hpp>
+#include <rlfw/InputDelta.hpp>
+#include <rlfw/InputSnapshot.hpp>
+#include <rlfw/StartupTimeline.hpp>
+#include <rlfw/Task.hpp>
+#include <rlfw/Timer.hpp>
+#include <rlfw/Watchdog.hpp>
 
 namespace rl
 {
     void run(rl::App& app);
+    // Runs each app as an independent headless instance, with its own event queue, input state,
+    // layers, tasks and timers, and no window. Instances run their frames independently of each
+    // other on a pool of thread_count threads, the calling thread included, which defaults to the
+    // hardware concurrency. Returns once every instance has closed, rethrowing the exception of
+    // the first failed app in apps. rl:: functions called from an instance act on that instance.
+    void run_headless(std::span<rl::App* const> apps, std::size_t thread_count = 0);
     bool get_is_running() noexcept;
     void try_close();
     void force_close();
+    // Layers sit above the app passed to rl::run() and receive its frame hooks bottom to top, and
+    // the events selected by their mask top to bottom until a handler calls rl::consume_event().
+    // Changes to the stack take effect from the next event.
+    void push_layer(rl::App& layer, rl::EventMask events = rl::EventMask::All);
+    void pop_layer();
+    void consume_event() noexcept;
     std::string_view get_window_title();
     void set_window_title(std::string_view title);
     void set_window_size(const rl::cell_vector2<int>& size);
     void set_window_size(int width, int height);
     rl::cell_vector2<int> get_window_size();
+    // OnFramebufferSizeSettled fires once the framebuffer size has not changed for this long.
+    void set_resize_settle_delay(std::chrono::milliseconds delay);
+    std::chrono::milliseconds get_resize_settle_delay();
+    rl::vector2<float> get_content_scale();
     void set_window_visible(bool visible);
     bool get_window_visible();
+    // When enabled rl::run() creates the window hidden and shows it once the first frame is done,
+    // so it never appears blank. Only takes effect when set before the window is created.
+    void set_show_window_after_first_frame(bool show_after_first_frame);
+    bool get_show_window_after_first_frame();
     void set_window_resizable(bool resizable);
     bool get_window_resizable();
     void set_window_decorated(bool decorated);
     bool get_window_decorated();
+    bool get_window_focused();
+    bool get_window_iconified();
+    bool get_window_occluded();
+    // When enabled the loop sleeps until a platform event arrives or a timer is due, instead of
+    // polling every frame, whenever no event or task is pending.
+    void set_wait_events(bool wait_events);
+    bool get_wait_events();
+    void set_background_policy(const rl::BackgroundPolicy& policy);
+    const rl::BackgroundPolicy& get_background_policy();
+    // The returned view is owned by the platform and is valid until the clipboard is read again.
+    std::string_view get_clipboard();
+    void set_clipboard(std::string_view text);
+    // Opens a shared memory channel that rl::InjectionClient in another local process can push
+    // input events into. They are merged into each frame after the platform's events. An empty
+    // name closes the channel. Throws where POSIX shared memory is not available.
+    void set_input_injection_channel(std::string_view channel);
+    std::string_view get_input_injection_channel();
     bool get_mouse_entered();
+    // The cursor position is mapped to the cell (position - origin) / size, rounded down, and
+    // OnMouseCell fires only when that cell changes. Cells are 1 by 1 pixels by default.
+    void set_mouse_cell_size(const rl::cell_vector2<int>& size);
+    rl::cell_vector2<int> get_mouse_cell_size();
+    void set_mouse_cell_origin(const rl::vector2<double>& origin);
+    rl::vector2<double> get_mouse_cell_origin();
+    // Empty until the cursor position is first known, and OnMouseCell always fires for that cell.
+    std::optional<rl::cell_vector2<int>> get_mouse_cell();
     bool get_pressed(rl::MouseButton button);
     bool get_pressed(rl::KeyboardKey key);
     bool get_ctrl_pressed();
     bool get_alt_pressed();
     bool get_shift_pressed();
     bool get_super_pressed();
+    // Safe to call from any thread. Returns the input state as of the last processed frame.
+    rl::InputSnapshot get_input_snapshot() noexcept;
 }
@@ -0,0 +1,170 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/InjectionClient.hpp>
+#include "InjectionRing.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RLFW_HAS_INJECTION
+#endif
+
+rl::InjectionClient::InjectionClient(std::string_view channel)
+{
+#ifdef RLFW_HAS_INJECTION
+    const auto shm_name = rl::get_injection_shm_name(channel);
+    const int descriptor = shm_open(shm_name.c_str(), O_RDWR, 0);
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("failed to open injection channel: " +
+                                 std::string(std::strerror(errno)));
+    }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 &&
+        static_cast<std::size_t>(status.st_size) >= sizeof(rl::InjectionRing))
+    {
+        mapping = mmap(nullptr,
+                       sizeof(rl::InjectionRing),
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED,
+                       descriptor,
+                       0);
+    }
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("injection channel is not mappable");
+    }
+    this->ring = static_cast<rl::InjectionRing*>(mapping);
+    const bool compatible =
+        this->ring->magic.load(std::memory_order_acquire) == rl::InjectionRing::MAGIC &&
+        this->ring->version == rl::InjectionRing::VERSION &&
+        this->ring->event_size == sizeof(rl::PlatformEvent) &&
+        this->ring->capacity == rl::InjectionRing::CAPACITY;
+    if (!compatible)
+    {
+        munmap(mapping, sizeof(rl::InjectionRing));
+        throw std::runtime_error("injection channel was created by an incompatible rlfw");
+    }
+    // continue after whatever a previous client left behind
+    this->head = this->ring->head.load(std::memory_order_relaxed);
+    this->cached_tail = this->ring->tail.load(std::memory_order_acquire);
+#else
+    throw std::runtime_error("input injection requires POSIX shared memory");
+#endif
+}
+
+rl::InjectionClient::~InjectionClient()
+{
+#ifdef RLFW_HAS_INJECTION
+    munmap(this->ring, sizeof(rl::InjectionRing));
+#endif
+}
+
+template<typename Event>
+bool rl::InjectionClient::push(const Event& event)
+{
+    if (this->head - this->cached_tail == rl::InjectionRing::CAPACITY)
+    {
+        // the app's position is only reread when the ring looks full, so most pushes do not
+        // touch the cache line it writes
+        this->cached_tail = this->ring->tail.load(std::memory_order_acquire);
+        if (this->head - this->cached_tail == rl::InjectionRing::CAPACITY)
+        {
+            return false;
+        }
+    }
+    this->ring->events[this->head & (rl::InjectionRing::CAPACITY - 1)] = event;
+    this->head++;
+    this->ring->head.store(this->head, std::memory_order_release);
+    return true;
+}
+
+bool rl::InjectionClient::push_keyboard_key(rl::KeyboardKey key, bool pressed)
+{
+    if (!rl::get_is_injectable_key(key))
+    {
+        throw std::runtime_error("injected keys must be between Space and Last");
+    }
+    rl::KeyboardKeyEvent event;
+    event.keyboard_key = key;
+    event.pressed = pressed;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_keyboard_character(unsigned int codepoint)
+{
+    rl::KeyboardCharacterEvent event;
+    event.codepoint = codepoint;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_mouse_button(rl::MouseButton button, bool pressed)
+{
+    if (!rl::get_is_injectable_button(button))
+    {
+        throw std::runtime_error("injected mouse buttons must be between Left and X6");
+    }
+    rl::MouseButtonEvent event;
+    event.mouse_button = button;
+    event.pressed = pressed;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_mouse_position(const rl::vector2<double>& position)
+{
+    rl::MousePositionEvent event;
+    event.position = position;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_mouse_cell(const rl::cell_vector2<int>& cell)
+{
+    rl::MouseCellEvent event;
+    event.cell = cell;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_mouse_scroll(const rl::vector2<double>& translation)
+{
+    rl::MouseScrollEvent event;
+    event.translation = translation;
+    return this->push(event);
+}
+
+bool rl::InjectionClient::push_try_close()
+{
+    return this->push(rl::WindowCloseEvent());
+}
+
+std::size_t rl::InjectionClient::get_free_capacity() noexcept
+{
+    this->cached_tail = this->ring->tail.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(rl::InjectionRing::CAPACITY - (this->head - this->cached_tail));
+}
@@ -28,6 +28,15 @@
 #include <stdexcept>
 #include <variant>
 
+// Tasks are coroutines resumed by the main loop. This one waits for the h key, then for a second, without a state machine.
+rl::Task greet_on_h()
+{
+  co_await rl::key_pressed(rl::KeyboardKey::H);
+  std::cout << "hello" << std::endl;
+  co_await rl::delay(std::chrono::seconds(1));
+  std::cout << "one second later" << std::endl;
+}
+
 class MyApp : public rl::App
 {
   public:
@@ -37,12 +46,19 @@ class MyApp : public rl::App
       rl::set_window_size(512, 512);
       rl::set_window_title("My App Window");
       rl::set_window_resizable(true);
+      rl::set_show_window_after_first_frame(true);
+    }
+
+    // Called on a worker thread while the window is being created. Resource files can be read from disk here.
+    void OnPrefetchResources() override
+    {
+
     }
 
     // Called right after window is created. Graphics resources can be loaded here.
     void OnLoadResources() override
     {
-      
+      rl::spawn(greet_on_h());
     }
 
     // Called at the start of every update frame, before any events have been processed.
@@ -60,6 +76,18 @@ class MyApp : public rl::App
       std::cout << "framebuffer size changed. Previous size: " << previous_size << " new size: " << size << " Change amount: " << size_change << std::endl;
     }
 
+    // Called once the framebuffer size has stopped changing for the resize settle delay. Rebuild expensive size dependent resources here.
+    void OnFramebufferSizeSettled(const rl::cell_vector2<int>& size) override
+    {
+      std::cout << "framebuffer size settled: " << size << std::endl;
+    }
+
+    // Called when the window moves to a monitor with a different content scale (DPI).
+    void OnContentScale(const rl::vector2<float>& scale) override
+    {
+      std::cout << "content scale changed: " << scale << std::endl;
+    }
+
     // Called when a mouse button event is processed.
     void OnMouseButton(rl::MouseButton button, bool pressed) override
     {
@@ -72,6 +100,12 @@ class MyApp : public rl::App
       //std::cout << "mouse position: " << position << std::endl;
     }
     
+    // Called when the mouse moves into a different cell of the grid set with rl::set_mouse_cell_size.
+    void OnMouseCell(const rl::cell_vector2<int>& cell) override
+    {
+      //std::cout << "mouse cell: " << cell << std::endl;
+    }
+    
     // Called when a mouse enter event is processed.
     void OnMouseEnter(bool entered) override
     {
@@ -123,7 +157,34 @@ class MyApp : public rl::App
     {
 
     }
+
+    // Called when files or folders are dropped onto the window. The paths are only valid during this call.
+    void OnFileDrop(std::span<const std::string_view> paths) override
+    {
+      for (const auto path : paths)
+      {
+        std::cout << "file dropped: " << path << std::endl;
+      }
+    }
+
+    // Called when the paste shortcut is pressed. The text is only valid during this call.
+    void OnClipboardPaste(std::string_view text) override
+    {
+      std::cout << "pasted " << text.size() << " bytes" << std::endl;
+    }
     
+    // Called when the window gains or loses input focus. While unfocused the loop is capped by the background policy.
+    void OnWindowFocus(bool focused) override
+    {
+      std::cout << (focused ? "window focused" : "window unfocused") << std::endl;
+    }
+
+    // Called when the window is minimized or restored. While minimized the loop is capped and drawing is skipped.
+    void OnWindowIconify(bool iconified) override
+    {
+      std::cout << (iconified ? "window minimized" : "window restored") << std::endl;
+    }
+
     // Called when the window is manually closed or rl::try_close() was called. rl::force_close() bypasses this.
     bool OnTryClose() override
     {
@@ -146,7 +207,7 @@ class MyApp : public rl::App
     // Called right before the application closes.
     void OnAppStop() override
     {
-
+      rl::dump_startup_timeline(std::cout);
     }
 };
 
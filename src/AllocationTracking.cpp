@@ -0,0 +1,323 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AllocationTracking.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define RLFW_HAS_BACKTRACE
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace
+{
+    // Thread locals with constant initializers need no guard, so they are safe to touch from
+    // operator new at any point of a thread's life.
+    thread_local rl::AllocationCounters sCOUNTERS = {};
+    thread_local rl::FramePhase sPHASE = rl::FramePhase::None;
+    thread_local bool sIN_HANDLER = false;
+    std::atomic<std::uint32_t> sHOT_PHASES = 0;
+    std::atomic<rl::AllocationHandler> sALLOCATION_HANDLER = nullptr;
+
+    constexpr std::array<const char*, rl::frame_phase_count> sPHASE_NAMES = {
+        "None",
+        "FrameStart",
+        "Poll",
+        "Dispatch",
+        "Timers",
+        "Tasks",
+        "Update",
+        "Draw"
+    };
+
+    void print_allocation(const rl::AllocationReport& report)
+    {
+        std::fprintf(stderr,
+                     "rlfw: %zu byte allocation in hot phase %s from %p\n",
+                     report.size,
+                     rl::get_frame_phase_name(report.phase),
+                     report.call_site);
+#ifdef RLFW_HAS_BACKTRACE
+        void* frames[32];
+        const int frame_count = backtrace(frames, 32);
+        backtrace_symbols_fd(frames, frame_count, 2);
+#endif
+    }
+
+    [[maybe_unused]] void track_allocation(std::size_t size, const void* call_site) noexcept
+    {
+        if (sIN_HANDLER)
+        {
+            return;
+        }
+        const auto phase = static_cast<std::size_t>(sPHASE);
+        sCOUNTERS.allocation_counts[phase]++;
+        sCOUNTERS.allocated_bytes[phase] += size;
+        if ((sHOT_PHASES.load(std::memory_order_relaxed) & (1u << phase)) == 0)
+        {
+            return;
+        }
+        sCOUNTERS.hot_allocation_count++;
+        rl::AllocationReport report;
+        report.phase = sPHASE;
+        report.size = size;
+        report.call_site = call_site;
+        auto handler = sALLOCATION_HANDLER.load(std::memory_order_acquire);
+        sIN_HANDLER = true;
+        (handler != nullptr ? handler : print_allocation)(report);
+        sIN_HANDLER = false;
+    }
+
+    [[maybe_unused]] void track_deallocation(void* pointer) noexcept
+    {
+        if (pointer != nullptr && !sIN_HANDLER)
+        {
+            sCOUNTERS.deallocation_count++;
+        }
+    }
+}
+
+const char* rl::get_frame_phase_name(rl::FramePhase phase) noexcept
+{
+    return sPHASE_NAMES[static_cast<std::size_t>(phase)];
+}
+
+void rl::set_allocation_phase(rl::FramePhase phase) noexcept
+{
+    sPHASE = phase;
+}
+
+rl::FramePhase rl::get_allocation_phase() noexcept
+{
+    return sPHASE;
+}
+
+const rl::AllocationCounters& rl::get_allocation_counters() noexcept
+{
+    return sCOUNTERS;
+}
+
+void rl::set_hot_phase(rl::FramePhase phase, bool hot) noexcept
+{
+#ifdef RLFW_HAS_BACKTRACE
+    // the first backtrace loads the unwinder, which allocates, so it is done here rather than in
+    // the middle of a report
+    void* frame;
+    backtrace(&frame, 1);
+#endif
+    const auto bit = 1u << static_cast<std::uint32_t>(phase);
+    if (hot)
+    {
+        sHOT_PHASES.fetch_or(bit, std::memory_order_relaxed);
+    }
+    else
+    {
+        sHOT_PHASES.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+bool rl::get_hot_phase(rl::FramePhase phase) noexcept
+{
+    return (sHOT_PHASES.load(std::memory_order_relaxed) &
+            (1u << static_cast<std::uint32_t>(phase))) != 0;
+}
+
+void rl::set_allocation_handler(rl::AllocationHandler handler) noexcept
+{
+    sALLOCATION_HANDLER.store(handler, std::memory_order_release);
+}
+
+#ifdef RLFW_ALLOCATION_TRACKING
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RLFW_CALL_SITE __builtin_return_address(0)
+#else
+#define RLFW_CALL_SITE nullptr
+#endif
+
+namespace
+{
+    void* allocate(std::size_t size) noexcept
+    {
+        return std::malloc(size != 0 ? size : 1);
+    }
+
+    void* allocate_aligned(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a size that is a multiple of the alignment
+        size = (size + align - 1) / align * align;
+#ifdef _WIN32
+        return _aligned_malloc(size != 0 ? size : align, align);
+#else
+        return std::aligned_alloc(align, size != 0 ? size : align);
+#endif
+    }
+
+    void deallocate_aligned(void* pointer) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// The replaceable global allocation functions. The call site is the return address of these, so
+// the allocating forms do not forward to each other.
+
+void* operator new(std::size_t size)
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    if (void* pointer = allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    if (void* pointer = allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    if (void* pointer = allocate_aligned(size, alignment))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    if (void* pointer = allocate_aligned(size, alignment))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    track_allocation(size, RLFW_CALL_SITE);
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    track_deallocation(pointer);
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    track_deallocation(pointer);
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete[](pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    operator delete[](pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    track_deallocation(pointer);
+    deallocate_aligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    track_deallocation(pointer);
+    deallocate_aligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete[](pointer, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    operator delete[](pointer, alignment);
+}
+
+#endif
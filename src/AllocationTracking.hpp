@@ -0,0 +1,45 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <rlfw/FrameStats.hpp>
+#include <array>
+#include <cstdint>
+
+namespace rl
+{
+    // Running totals of the calling thread's heap activity since it started, split by the phase
+    // it was in. The loop diffs them around each frame to fill in rl::FrameStats.
+    struct AllocationCounters
+    {
+        std::array<std::uint64_t, rl::frame_phase_count> allocation_counts;
+        std::array<std::uint64_t, rl::frame_phase_count> allocated_bytes;
+        std::uint64_t deallocation_count;
+        std::uint64_t hot_allocation_count;
+    };
+
+    void set_allocation_phase(rl::FramePhase phase) noexcept;
+    rl::FramePhase get_allocation_phase() noexcept;
+    const rl::AllocationCounters& get_allocation_counters() noexcept;
+}
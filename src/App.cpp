@@ -27,6 +27,10 @@ void rl::App::OnAppStart()
 {
 }
 
+void rl::App::OnPrefetchResources()
+{
+}
+
 void rl::App::OnLoadResources()
 {
 
@@ -40,6 +44,14 @@ void rl::App::OnFramebufferSize(const rl::cell_vector2<int>& size)
 {
 }
 
+void rl::App::OnFramebufferSizeSettled(const rl::cell_vector2<int>& size)
+{
+}
+
+void rl::App::OnContentScale(const rl::vector2<float>& scale)
+{
+}
+
 void rl::App::OnMouseButton(rl::MouseButton button, bool pressed)
 {
 }
@@ -48,6 +60,10 @@ void rl::App::OnMousePosition(const rl::vector2<double>& position)
 {
 }
 
+void rl::App::OnMouseCell(const rl::cell_vector2<int>& cell)
+{
+}
+
 void rl::App::OnMouseEnter(bool entered)
 {
 }
@@ -64,6 +80,22 @@ void rl::App::OnKeyboardCharacter(unsigned int codepoint)
 {
 }
 
+void rl::App::OnFileDrop(std::span<const std::string_view> paths)
+{
+}
+
+void rl::App::OnClipboardPaste(std::string_view text)
+{
+}
+
+void rl::App::OnWindowFocus(bool focused)
+{
+}
+
+void rl::App::OnWindowIconify(bool iconified)
+{
+}
+
 bool rl::App::OnTryClose()
 {
     return true;
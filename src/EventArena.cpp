@@ -0,0 +1,66 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EventArena.hpp"
+
+std::uint32_t rl::EventArena::push_string(std::string_view text)
+{
+    Entry entry;
+    entry.offset = static_cast<std::uint32_t>(this->bytes.size());
+    entry.length = static_cast<std::uint32_t>(text.size());
+    this->bytes.insert(this->bytes.end(), text.begin(), text.end());
+    this->entries.push_back(entry);
+    return static_cast<std::uint32_t>(this->entries.size() - 1);
+}
+
+std::uint32_t rl::EventArena::get_string_count() const noexcept
+{
+    return static_cast<std::uint32_t>(this->entries.size());
+}
+
+void rl::EventArena::resolve()
+{
+    this->views.clear();
+    for (const auto& entry : this->entries)
+    {
+        this->views.emplace_back(this->bytes.data() + entry.offset, entry.length);
+    }
+}
+
+std::string_view rl::EventArena::get_string(std::uint32_t index) const
+{
+    return this->views[index];
+}
+
+std::span<const std::string_view> rl::EventArena::get_strings(std::uint32_t first,
+                                                              std::uint32_t count) const
+{
+    return std::span<const std::string_view>(this->views).subspan(first, count);
+}
+
+void rl::EventArena::clear() noexcept
+{
+    this->bytes.clear();
+    this->entries.clear();
+    this->views.clear();
+}
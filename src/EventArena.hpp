@@ -0,0 +1,59 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace rl
+{
+    // Per frame storage for the variable length payloads of platform events. Events only hold
+    // string indices into the arena, so the event variant stays small and pushing payloads while
+    // events are polled cannot invalidate earlier ones. The views handed to handlers are resolved
+    // once polling is done and stay valid until the arena is cleared at the end of dispatch. The
+    // buffers keep their capacity between frames, so steady state payloads do not allocate.
+    class EventArena
+    {
+    public:
+        std::uint32_t push_string(std::string_view text);
+        std::uint32_t get_string_count() const noexcept;
+        void resolve();
+        std::string_view get_string(std::uint32_t index) const;
+        std::span<const std::string_view> get_strings(std::uint32_t first,
+                                                      std::uint32_t count) const;
+        void clear() noexcept;
+
+    private:
+        struct Entry
+        {
+            std::uint32_t offset;
+            std::uint32_t length;
+        };
+        std::vector<char> bytes;
+        std::vector<Entry> entries;
+        std::vector<std::string_view> views;
+    };
+}
@@ -0,0 +1,95 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "PlatformEvent.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace rl
+{
+    // Layout of the POSIX shared memory region behind an input injection channel. The rlfw app
+    // creates the region and is its only consumer, and one external process at a time writes
+    // events into it through rl::InjectionClient. Events are stored as the PlatformEvent variant
+    // itself, so both sides must be built from the same rlfw version, which the header checks.
+    struct InjectionRing
+    {
+        static constexpr std::uint32_t MAGIC = 0x524C4649; // "RLFI"
+        static constexpr std::uint32_t VERSION = 1;
+        static constexpr std::uint64_t CAPACITY = 8192;
+
+        // written last by the app, once the rest of the header is valid
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::uint32_t event_size;
+        std::uint32_t capacity;
+        // written only by the client, and the number of events ever pushed
+        alignas(64) std::atomic<std::uint64_t> head;
+        // written only by the app, and the number of events ever consumed
+        alignas(64) std::atomic<std::uint64_t> tail;
+        alignas(64) rl::PlatformEvent events[CAPACITY];
+    };
+    static_assert((rl::InjectionRing::CAPACITY & (rl::InjectionRing::CAPACITY - 1)) == 0,
+                  "the ring capacity must be a power of two");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                      std::atomic<std::uint32_t>::is_always_lock_free,
+                  "ring positions are shared between processes, so they must be lock free");
+    static_assert(std::is_trivially_copyable_v<rl::PlatformEvent>,
+                  "injected events are copied between processes as bytes");
+
+    // Maps a channel name to the name of its shared memory object.
+    inline std::string get_injection_shm_name(std::string_view channel)
+    {
+        if (channel.empty() || channel.find('/') != std::string_view::npos)
+        {
+            throw std::runtime_error("injection channel names must be non empty and without slashes");
+        }
+        return "/rlfw-" + std::string(channel);
+    }
+
+    // Keys and buttons outside these ranges would index past the consumer's input state.
+    inline bool get_is_injectable_key(rl::KeyboardKey key) noexcept
+    {
+        return key >= rl::KeyboardKey::Space && key <= rl::KeyboardKey::Last;
+    }
+
+    inline bool get_is_injectable_button(rl::MouseButton button) noexcept
+    {
+        return button >= rl::MouseButton::Left && button <= rl::MouseButton::X6;
+    }
+
+    // Only events with a fixed size payload can be injected, as the others refer to the
+    // consumer's rl::EventArena.
+    inline bool get_is_injectable(const rl::PlatformEvent& event) noexcept
+    {
+        return event.index() < std::variant_size_v<rl::PlatformEvent> &&
+               !std::holds_alternative<rl::FileDropEvent>(event) &&
+               !std::holds_alternative<rl::ClipboardPasteEvent>(event);
+    }
+}
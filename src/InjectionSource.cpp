@@ -0,0 +1,164 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InjectionSource.hpp"
+#include "InjectionRing.hpp"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define RLFW_HAS_INJECTION
+#endif
+
+namespace
+{
+    // A bool copied out of shared memory may hold any byte, and loading one that is neither 0
+    // nor 1 is undefined, so its byte is read instead.
+    void normalize_bool(bool& value) noexcept
+    {
+        unsigned char byte;
+        std::memcpy(&byte, &value, sizeof(byte));
+        value = byte != 0;
+    }
+
+    // Repairs the payload of an event written by another process, or returns false when it can
+    // not be trusted. The variant index has already been checked.
+    bool sanitize_event(rl::PlatformEvent& event) noexcept
+    {
+        if (auto* key_event = std::get_if<rl::KeyboardKeyEvent>(&event))
+        {
+            normalize_bool(key_event->pressed);
+            return rl::get_is_injectable_key(key_event->keyboard_key);
+        }
+        if (auto* button_event = std::get_if<rl::MouseButtonEvent>(&event))
+        {
+            normalize_bool(button_event->pressed);
+            return rl::get_is_injectable_button(button_event->mouse_button);
+        }
+        if (auto* enter_event = std::get_if<rl::MouseEnterEvent>(&event))
+        {
+            normalize_bool(enter_event->entered);
+        }
+        else if (auto* focus_event = std::get_if<rl::WindowFocusEvent>(&event))
+        {
+            normalize_bool(focus_event->focused);
+        }
+        else if (auto* iconify_event = std::get_if<rl::WindowIconifyEvent>(&event))
+        {
+            normalize_bool(iconify_event->iconified);
+        }
+        return true;
+    }
+}
+
+rl::InjectionSource::InjectionSource(std::string_view channel)
+    : channel(channel)
+    , shm_name(rl::get_injection_shm_name(channel))
+{
+#ifdef RLFW_HAS_INJECTION
+    // a ring left behind by a crashed run may still be mapped by its old client
+    shm_unlink(this->shm_name.c_str());
+    const int descriptor = shm_open(this->shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("failed to create injection channel: " +
+                                 std::string(std::strerror(errno)));
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(descriptor, sizeof(rl::InjectionRing)) == 0)
+    {
+        mapping = mmap(nullptr,
+                       sizeof(rl::InjectionRing),
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED,
+                       descriptor,
+                       0);
+    }
+    const int error = errno;
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        shm_unlink(this->shm_name.c_str());
+        throw std::runtime_error("failed to map injection channel: " +
+                                 std::string(std::strerror(error)));
+    }
+    this->ring = new (mapping) rl::InjectionRing;
+    this->ring->version = rl::InjectionRing::VERSION;
+    this->ring->event_size = sizeof(rl::PlatformEvent);
+    this->ring->capacity = rl::InjectionRing::CAPACITY;
+    this->ring->head.store(0, std::memory_order_relaxed);
+    this->ring->tail.store(0, std::memory_order_relaxed);
+    this->ring->magic.store(rl::InjectionRing::MAGIC, std::memory_order_release);
+#else
+    throw std::runtime_error("input injection requires POSIX shared memory");
+#endif
+}
+
+rl::InjectionSource::~InjectionSource()
+{
+#ifdef RLFW_HAS_INJECTION
+    munmap(this->ring, sizeof(rl::InjectionRing));
+    shm_unlink(this->shm_name.c_str());
+#endif
+}
+
+std::string_view rl::InjectionSource::get_channel() const noexcept
+{
+    return this->channel;
+}
+
+bool rl::InjectionSource::get_has_pending() const noexcept
+{
+    return this->ring->head.load(std::memory_order_acquire) !=
+           this->ring->tail.load(std::memory_order_relaxed);
+}
+
+std::size_t rl::InjectionSource::drain(std::vector<rl::PlatformEvent>& events)
+{
+    const auto tail = this->ring->tail.load(std::memory_order_relaxed);
+    const auto head = this->ring->head.load(std::memory_order_acquire);
+    // a client that overran the ring or wrote garbage positions is ignored rather than trusted
+    if (head - tail > rl::InjectionRing::CAPACITY)
+    {
+        this->ring->tail.store(head, std::memory_order_release);
+        return 0;
+    }
+    events.reserve(events.size() + static_cast<std::size_t>(head - tail));
+    std::size_t count = 0;
+    for (auto position = tail; position != head; position++)
+    {
+        // copied first, so the client cannot change the event between checking and using it
+        auto event = this->ring->events[position & (rl::InjectionRing::CAPACITY - 1)];
+        if (rl::get_is_injectable(event) && sanitize_event(event))
+        {
+            events.push_back(event);
+            count++;
+        }
+    }
+    this->ring->tail.store(head, std::memory_order_release);
+    return count;
+}
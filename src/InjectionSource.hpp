@@ -0,0 +1,55 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "PlatformEvent.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rl
+{
+    struct InjectionRing;
+
+    // The app side of an input injection channel. It creates the shared memory ring on
+    // construction, replacing any left behind by a previous run, and unlinks it on destruction.
+    class InjectionSource
+    {
+    public:
+        explicit InjectionSource(std::string_view channel);
+        ~InjectionSource();
+        InjectionSource(const InjectionSource&) = delete;
+        InjectionSource& operator=(const InjectionSource&) = delete;
+
+        std::string_view get_channel() const noexcept;
+        bool get_has_pending() const noexcept;
+        // Appends every event the client has published so far and frees their slots.
+        std::size_t drain(std::vector<rl::PlatformEvent>& events);
+
+    private:
+        std::string channel;
+        std::string shm_name;
+        rl::InjectionRing* ring = nullptr;
+    };
+}
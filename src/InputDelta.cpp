@@ -0,0 +1,359 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/InputDelta.hpp>
+#include "EventPump.hpp"
+#include "PlatformEvent.hpp"
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    enum InputDeltaFlags : std::uint8_t
+    {
+        KEYS_CHANGED = 1 << 0,
+        BUTTONS_CHANGED = 1 << 1,
+        MOUSE_MOVED = 1 << 2,
+        MOUSE_SCROLLED = 1 << 3
+    };
+
+    constexpr std::uint8_t sKNOWN_FLAGS =
+        KEYS_CHANGED | BUTTONS_CHANGED | MOUSE_MOVED | MOUSE_SCROLLED;
+
+    void write_varint(std::vector<std::uint8_t>& bytes, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // Maps signed values to unsigned ones so small magnitudes of either sign stay short.
+    std::uint64_t zigzag(std::int64_t value) noexcept
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value) noexcept
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    // Quantized values are kept within this many steps of zero, far beyond any real cursor, so
+    // the differences between them cannot overflow.
+    constexpr std::int64_t sMAX_STEPS = std::int64_t(1) << 40;
+
+    // Non-finite and huge values would make std::llround unspecified, so they are clamped, with
+    // NaN sent as zero.
+    std::int64_t quantize(double value, double step) noexcept
+    {
+        const double steps = value / step;
+        if (std::isnan(steps))
+        {
+            return 0;
+        }
+        if (steps >= static_cast<double>(sMAX_STEPS))
+        {
+            return sMAX_STEPS;
+        }
+        if (steps <= static_cast<double>(-sMAX_STEPS))
+        {
+            return -sMAX_STEPS;
+        }
+        return std::llround(steps);
+    }
+
+    // Visits the set bits in ascending order a word at a time, rather than testing every bit.
+    template<std::size_t Size, typename Visitor>
+    void for_each_set_bit(const std::bitset<Size>& bits, Visitor&& visitor)
+    {
+        const std::bitset<Size> word_mask(~0ull);
+        for (std::size_t base = 0; base < Size; base += 64)
+        {
+            auto word = ((bits >> base) & word_mask).to_ullong();
+            while (word != 0)
+            {
+                visitor(base + static_cast<std::size_t>(std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    class ByteReader
+    {
+    public:
+        explicit ByteReader(std::span<const std::uint8_t> bytes) noexcept
+            : bytes(bytes)
+        {
+        }
+
+        std::uint8_t read_byte()
+        {
+            if (this->position == this->bytes.size())
+            {
+                throw std::runtime_error("input delta is truncated");
+            }
+            return this->bytes[this->position++];
+        }
+
+        // Reads a zigzag varint that must lie within sMAX_STEPS of base, and returns base plus it.
+        std::int64_t read_steps(std::int64_t base)
+        {
+            const auto value = unzigzag(this->read_varint());
+            // base is within sMAX_STEPS, so once value is within twice that the sum cannot overflow
+            if (value < -2 * sMAX_STEPS || value > 2 * sMAX_STEPS ||
+                base + value < -sMAX_STEPS || base + value > sMAX_STEPS)
+            {
+                throw std::runtime_error("input delta has an out of range value");
+            }
+            return base + value;
+        }
+
+        std::uint64_t read_varint()
+        {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                const auto byte = this->read_byte();
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+            throw std::runtime_error("input delta has an overlong varint");
+        }
+
+        std::size_t get_position() const noexcept
+        {
+            return this->position;
+        }
+
+    private:
+        std::span<const std::uint8_t> bytes;
+        std::size_t position = 0;
+    };
+}
+
+rl::InputDeltaEncoder::InputDeltaEncoder(const rl::InputDeltaSettings& settings)
+    : settings(settings)
+{
+}
+
+std::size_t rl::InputDeltaEncoder::encode(const rl::InputSnapshot& snapshot,
+                                          std::vector<std::uint8_t>& bytes)
+{
+    const auto start = bytes.size();
+    const auto changed_keys = snapshot.keyboard_keys ^ this->keyboard_keys;
+    const auto changed_buttons = snapshot.mouse_buttons ^ this->mouse_buttons;
+    const auto mouse_x = quantize(snapshot.mouse_position.x, this->settings.mouse_position_step);
+    const auto mouse_y = quantize(snapshot.mouse_position.y, this->settings.mouse_position_step);
+    const auto scroll_x = quantize(snapshot.mouse_scroll.x, this->settings.mouse_scroll_step);
+    const auto scroll_y = quantize(snapshot.mouse_scroll.y, this->settings.mouse_scroll_step);
+    std::uint8_t flags = 0;
+    if (changed_keys.any())
+    {
+        flags |= KEYS_CHANGED;
+    }
+    if (changed_buttons.any())
+    {
+        flags |= BUTTONS_CHANGED;
+    }
+    if (mouse_x != this->mouse_x || mouse_y != this->mouse_y)
+    {
+        flags |= MOUSE_MOVED;
+    }
+    if (scroll_x != 0 || scroll_y != 0)
+    {
+        flags |= MOUSE_SCROLLED;
+    }
+    bytes.push_back(flags);
+    if (flags & KEYS_CHANGED)
+    {
+        write_varint(bytes, changed_keys.count());
+        std::size_t next_index = 0;
+        for_each_set_bit(
+            changed_keys,
+            [&](std::size_t index)
+            {
+                write_varint(bytes, index - next_index);
+                next_index = index + 1;
+            }
+        );
+    }
+    if (flags & BUTTONS_CHANGED)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(changed_buttons.to_ulong()));
+    }
+    if (flags & MOUSE_MOVED)
+    {
+        write_varint(bytes, zigzag(mouse_x - this->mouse_x));
+        write_varint(bytes, zigzag(mouse_y - this->mouse_y));
+    }
+    if (flags & MOUSE_SCROLLED)
+    {
+        write_varint(bytes, zigzag(scroll_x));
+        write_varint(bytes, zigzag(scroll_y));
+    }
+    this->keyboard_keys = snapshot.keyboard_keys;
+    this->mouse_buttons = snapshot.mouse_buttons;
+    this->mouse_x = mouse_x;
+    this->mouse_y = mouse_y;
+    return bytes.size() - start;
+}
+
+void rl::InputDeltaEncoder::reset() noexcept
+{
+    this->keyboard_keys.reset();
+    this->mouse_buttons.reset();
+    this->mouse_x = 0;
+    this->mouse_y = 0;
+}
+
+rl::InputDeltaDecoder::InputDeltaDecoder(const rl::InputDeltaSettings& settings)
+    : settings(settings)
+{
+}
+
+std::size_t rl::InputDeltaDecoder::decode(std::span<const std::uint8_t> bytes)
+{
+    // the whole frame is read before anything is applied, so bad input changes nothing
+    ByteReader reader(bytes);
+    const auto flags = reader.read_byte();
+    if ((flags & ~sKNOWN_FLAGS) != 0)
+    {
+        throw std::runtime_error("input delta has unknown flags");
+    }
+    std::bitset<348> changed_keys;
+    if (flags & KEYS_CHANGED)
+    {
+        const auto count = reader.read_varint();
+        if (count == 0 || count > changed_keys.size())
+        {
+            throw std::runtime_error("input delta has an invalid key count");
+        }
+        std::uint64_t next_index = 0;
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            const auto index = next_index + reader.read_varint();
+            if (index >= changed_keys.size())
+            {
+                throw std::runtime_error("input delta has an invalid key");
+            }
+            changed_keys.set(index);
+            next_index = index + 1;
+        }
+    }
+    std::bitset<8> changed_buttons;
+    if (flags & BUTTONS_CHANGED)
+    {
+        changed_buttons = reader.read_byte();
+    }
+    auto mouse_x = this->mouse_x;
+    auto mouse_y = this->mouse_y;
+    if (flags & MOUSE_MOVED)
+    {
+        mouse_x = reader.read_steps(mouse_x);
+        mouse_y = reader.read_steps(mouse_y);
+    }
+    std::int64_t scroll_x = 0;
+    std::int64_t scroll_y = 0;
+    if (flags & MOUSE_SCROLLED)
+    {
+        scroll_x = reader.read_steps(0);
+        scroll_y = reader.read_steps(0);
+    }
+    if (changed_keys.any())
+    {
+        this->state.keyboard_keys ^= changed_keys;
+        for_each_set_bit(
+            changed_keys,
+            [&](std::size_t index)
+            {
+                rl::KeyboardKeyEvent event;
+                event.keyboard_key = static_cast<rl::KeyboardKey>(index + 1);
+                event.pressed = this->state.keyboard_keys.test(index);
+                rl::push_event(event);
+            }
+        );
+    }
+    if (changed_buttons.any())
+    {
+        this->state.mouse_buttons ^= changed_buttons;
+        for_each_set_bit(
+            changed_buttons,
+            [&](std::size_t index)
+            {
+                rl::MouseButtonEvent event;
+                event.mouse_button = static_cast<rl::MouseButton>(index);
+                event.pressed = this->state.mouse_buttons.test(index);
+                rl::push_event(event);
+            }
+        );
+    }
+    if (flags & MOUSE_MOVED)
+    {
+        this->mouse_x = mouse_x;
+        this->mouse_y = mouse_y;
+        this->state.mouse_position = rl::vector2<double>(
+            static_cast<double>(mouse_x) * this->settings.mouse_position_step,
+            static_cast<double>(mouse_y) * this->settings.mouse_position_step);
+        rl::MousePositionEvent event;
+        event.position = this->state.mouse_position;
+        rl::push_event(event);
+    }
+    this->state.mouse_scroll = rl::vector2<double>(
+        static_cast<double>(scroll_x) * this->settings.mouse_scroll_step,
+        static_cast<double>(scroll_y) * this->settings.mouse_scroll_step);
+    if (flags & MOUSE_SCROLLED)
+    {
+        rl::MouseScrollEvent event;
+        event.translation = this->state.mouse_scroll;
+        rl::push_event(event);
+    }
+    this->state.frame++;
+    this->state.ctrl_pressed = this->state.get_pressed(rl::KeyboardKey::LeftControl) ||
+                               this->state.get_pressed(rl::KeyboardKey::RightControl);
+    this->state.alt_pressed = this->state.get_pressed(rl::KeyboardKey::LeftAlt) ||
+                              this->state.get_pressed(rl::KeyboardKey::RightAlt);
+    this->state.shift_pressed = this->state.get_pressed(rl::KeyboardKey::LeftShift) ||
+                                this->state.get_pressed(rl::KeyboardKey::RightShift);
+    this->state.super_pressed = this->state.get_pressed(rl::KeyboardKey::LeftSuper) ||
+                                this->state.get_pressed(rl::KeyboardKey::RightSuper);
+    return reader.get_position();
+}
+
+const rl::InputSnapshot& rl::InputDeltaDecoder::get_state() const noexcept
+{
+    return this->state;
+}
+
+void rl::InputDeltaDecoder::reset() noexcept
+{
+    this->state = rl::InputSnapshot();
+    this->mouse_x = 0;
+    this->mouse_y = 0;
+}
@@ -23,10 +23,14 @@
 
 #pragma once
 
+#include <rlfw/EventMask.hpp>
 #include <rlfw/KeyboardKey.hpp>
 #include <rlfw/MouseButton.hpp>
 #include <rlm/cellular/cell_vector2.hpp>
 #include <rlm/linear/vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <variant>
 
 namespace rl
@@ -35,6 +39,14 @@ namespace rl
     {
         rl::cell_vector2<int> size;
     };
+    struct FramebufferSizeSettledEvent
+    {
+        rl::cell_vector2<int> size;
+    };
+    struct ContentScaleEvent
+    {
+        rl::vector2<float> scale;
+    };
     struct MouseButtonEvent
     {
         rl::MouseButton mouse_button;
@@ -44,6 +56,10 @@ namespace rl
     {
         rl::vector2<double> position;
     };
+    struct MouseCellEvent
+    {
+        rl::cell_vector2<int> cell;
+    };
     struct MouseEnterEvent
     {
         bool entered;
@@ -61,15 +77,78 @@ namespace rl
     {
         unsigned int codepoint;
     };
+    struct WindowFocusEvent
+    {
+        bool focused;
+    };
+    struct WindowIconifyEvent
+    {
+        bool iconified;
+    };
+    // The payloads of these events live in the frame's rl::EventArena.
+    struct FileDropEvent
+    {
+        std::uint32_t first_path;
+        std::uint32_t path_count;
+    };
+    struct ClipboardPasteEvent
+    {
+        std::uint32_t text;
+    };
     struct WindowCloseEvent {};
     using PlatformEvent = std::variant<
             FramebufferSizeEvent,
+            FramebufferSizeSettledEvent,
+            ContentScaleEvent,
             MouseButtonEvent,
             MousePositionEvent,
+            MouseCellEvent,
             MouseEnterEvent,
             MouseScrollEvent,
             KeyboardKeyEvent,
             KeyboardCharacterEvent,
+            FileDropEvent,
+            ClipboardPasteEvent,
+            WindowFocusEvent,
+            WindowIconifyEvent,
             WindowCloseEvent
     >;
+    static_assert(sizeof(rl::PlatformEvent) <= 32, "platform events must stay small");
+
+    template<typename Event, typename... Events>
+    constexpr std::size_t get_event_index(const std::variant<Events...>*) noexcept
+    {
+        constexpr bool matches[] = {std::is_same_v<Event, Events>...};
+        std::size_t index = 0;
+        while (!matches[index]) index++;
+        return index;
+    }
+
+    template<typename Event>
+    constexpr std::size_t event_index =
+        rl::get_event_index<Event>(static_cast<const rl::PlatformEvent*>(nullptr));
+
+    // The bit of an event in rl::EventMask is 1 << event.index(), which these keep in sync.
+    template<typename Event>
+    constexpr bool get_event_mask_matches(rl::EventMask mask) noexcept
+    {
+        return static_cast<std::uint32_t>(mask) == (1u << rl::event_index<Event>);
+    }
+    static_assert(rl::get_event_mask_matches<FramebufferSizeEvent>(rl::EventMask::FramebufferSize));
+    static_assert(rl::get_event_mask_matches<FramebufferSizeSettledEvent>(
+        rl::EventMask::FramebufferSizeSettled));
+    static_assert(rl::get_event_mask_matches<ContentScaleEvent>(rl::EventMask::ContentScale));
+    static_assert(rl::get_event_mask_matches<MouseButtonEvent>(rl::EventMask::MouseButton));
+    static_assert(rl::get_event_mask_matches<MousePositionEvent>(rl::EventMask::MousePosition));
+    static_assert(rl::get_event_mask_matches<MouseCellEvent>(rl::EventMask::MouseCell));
+    static_assert(rl::get_event_mask_matches<MouseEnterEvent>(rl::EventMask::MouseEnter));
+    static_assert(rl::get_event_mask_matches<MouseScrollEvent>(rl::EventMask::MouseScroll));
+    static_assert(rl::get_event_mask_matches<KeyboardKeyEvent>(rl::EventMask::KeyboardKey));
+    static_assert(rl::get_event_mask_matches<KeyboardCharacterEvent>(
+        rl::EventMask::KeyboardCharacter));
+    static_assert(rl::get_event_mask_matches<FileDropEvent>(rl::EventMask::FileDrop));
+    static_assert(rl::get_event_mask_matches<ClipboardPasteEvent>(rl::EventMask::ClipboardPaste));
+    static_assert(rl::get_event_mask_matches<WindowFocusEvent>(rl::EventMask::WindowFocus));
+    static_assert(rl::get_event_mask_matches<WindowIconifyEvent>(rl::EventMask::WindowIconify));
+    static_assert(rl::get_event_mask_matches<WindowCloseEvent>(rl::EventMask::TryClose));
 }
@@ -0,0 +1,139 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Scheduler.hpp"
+
+rl::Scheduler::~Scheduler()
+{
+    for (auto handle : this->next_frame) handle.destroy();
+    for (auto handle : this->ready) handle.destroy();
+    for (auto handle : this->resuming) handle.destroy();
+    while (this->delayed != nullptr)
+    {
+        auto* next = this->delayed->next;
+        this->delayed->handle.destroy();
+        this->delayed = next;
+    }
+    for (auto* awaiter : this->key_waiters)
+    {
+        while (awaiter != nullptr)
+        {
+            // the awaiter lives in the frame being destroyed
+            auto* next = awaiter->next;
+            awaiter->handle.destroy();
+            awaiter = next;
+        }
+    }
+}
+
+void rl::Scheduler::resume(std::coroutine_handle<> handle)
+{
+    try
+    {
+        handle.resume();
+    }
+    catch (...)
+    {
+        // a task that throws is left suspended at its final suspend point
+        handle.destroy();
+        throw;
+    }
+}
+
+void rl::Scheduler::wait_next_frame(std::coroutine_handle<> handle)
+{
+    this->next_frame.push_back(handle);
+}
+
+void rl::Scheduler::wait_key_pressed(rl::KeyPressedAwaiter& awaiter)
+{
+    auto& head = this->key_waiters[static_cast<int>(awaiter.key) + 1];
+    awaiter.next = head;
+    head = &awaiter;
+}
+
+void rl::Scheduler::wait_delayed(rl::DelayAwaiter& awaiter)
+{
+    awaiter.previous = nullptr;
+    awaiter.next = this->delayed;
+    if (this->delayed != nullptr)
+    {
+        this->delayed->previous = &awaiter;
+    }
+    this->delayed = &awaiter;
+}
+
+void rl::Scheduler::notify_key_pressed(rl::KeyboardKey key)
+{
+    auto& head = this->key_waiters[static_cast<int>(key) + 1];
+    for (auto* awaiter = head; awaiter != nullptr; awaiter = awaiter->next)
+    {
+        this->ready.push_back(awaiter->handle);
+    }
+    head = nullptr;
+}
+
+void rl::Scheduler::notify_delayed(rl::DelayAwaiter& awaiter)
+{
+    if (awaiter.previous != nullptr)
+    {
+        awaiter.previous->next = awaiter.next;
+    }
+    else
+    {
+        this->delayed = awaiter.next;
+    }
+    if (awaiter.next != nullptr)
+    {
+        awaiter.next->previous = awaiter.previous;
+    }
+    this->ready.push_back(awaiter.handle);
+}
+
+bool rl::Scheduler::get_is_idle() const noexcept
+{
+    return this->next_frame.empty() && this->ready.empty();
+}
+
+void rl::Scheduler::update()
+{
+    this->ready.insert(this->ready.end(), this->next_frame.begin(), this->next_frame.end());
+    this->next_frame.clear();
+    // tasks that suspend again while the ready list is resumed wait for a later frame
+    std::swap(this->resuming, this->ready);
+    for (std::size_t i = 0; i < this->resuming.size(); i++)
+    {
+        try
+        {
+            this->resume(this->resuming[i]);
+        }
+        catch (...)
+        {
+            this->ready.insert(this->ready.end(), this->resuming.begin() + i + 1,
+                               this->resuming.end());
+            this->resuming.clear();
+            throw;
+        }
+    }
+    this->resuming.clear();
+}
@@ -0,0 +1,67 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <rlfw/Task.hpp>
+#include <vector>
+
+namespace rl
+{
+    // Owns every suspended rl::Task of a running loop. Suspended tasks sit in the wait list of the
+    // condition they await and are moved to the ready list when it fires, so nothing is polled.
+    // Delays are timers on the loop's rl::TimingWheel. Ready tasks are resumed once per frame by
+    // update(), after events have been dispatched and timers have fired.
+    class Scheduler
+    {
+    public:
+        Scheduler() = default;
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+        ~Scheduler();
+
+        void resume(std::coroutine_handle<> handle);
+        void wait_next_frame(std::coroutine_handle<> handle);
+        void wait_key_pressed(rl::KeyPressedAwaiter& awaiter);
+        void wait_delayed(rl::DelayAwaiter& awaiter);
+        void notify_key_pressed(rl::KeyboardKey key);
+        void notify_delayed(rl::DelayAwaiter& awaiter);
+        void update();
+        // True when no task will run on the next frame unless a condition fires first.
+        bool get_is_idle() const noexcept;
+
+    private:
+        std::vector<std::coroutine_handle<>> next_frame;
+        std::vector<std::coroutine_handle<>> ready;
+        std::vector<std::coroutine_handle<>> resuming;
+        rl::DelayAwaiter* delayed = nullptr;
+        // indexed by key + 1 so rl::KeyboardKey::Unkown has a slot
+        std::array<rl::KeyPressedAwaiter*, static_cast<int>(rl::KeyboardKey::Last) + 2>
+            key_waiters = {};
+    };
+
+    // Returns the scheduler of the running loop, creating it on first use.
+    rl::Scheduler& get_scheduler();
+}
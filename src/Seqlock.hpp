@@ -0,0 +1,89 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace rl
+{
+    // A single writer, many reader sequence lock. The value is stored as relaxed atomic words so
+    // a reader racing the writer sees a torn copy instead of undefined behavior, and the sequence
+    // check makes it retry until it has a consistent one. Readers never block the writer.
+    template<typename T>
+    class Seqlock
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static constexpr std::size_t word_count =
+            (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    public:
+        void store(const T& value) noexcept
+        {
+            std::array<std::uint64_t, word_count> words = {};
+            std::memcpy(words.data(), &value, sizeof(T));
+            const auto sequence = this->sequence.load(std::memory_order_relaxed);
+            this->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < word_count; i++)
+            {
+                this->words[i].store(words[i], std::memory_order_relaxed);
+            }
+            this->sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        T load() const noexcept
+        {
+            std::array<std::uint64_t, word_count> words;
+            while (true)
+            {
+                const auto before = this->sequence.load(std::memory_order_acquire);
+                if ((before & 1) == 0)
+                {
+                    for (std::size_t i = 0; i < word_count; i++)
+                    {
+                        words[i] = this->words[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (this->sequence.load(std::memory_order_relaxed) == before)
+                    {
+                        break;
+                    }
+                }
+                std::this_thread::yield();
+            }
+            T value;
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+            return value;
+        }
+
+    private:
+        alignas(64) std::atomic<std::uint64_t> sequence = 0;
+        alignas(64) std::array<std::atomic<std::uint64_t>, word_count> words = {};
+    };
+}
@@ -0,0 +1,70 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/StartupTimeline.hpp>
+#include <iomanip>
+
+namespace
+{
+    constexpr std::array<const char*, rl::startup_stage_count> sSTAGE_NAMES = {
+        "AppStart",
+        "Prefetch",
+        "PlatformInit",
+        "WindowCreation",
+        "PrefetchWait",
+        "LoadResources",
+        "CallbackSetup",
+        "FirstFrame"
+    };
+
+    double get_milliseconds(std::chrono::nanoseconds time) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+}
+
+const char* rl::get_startup_stage_name(rl::StartupStage stage) noexcept
+{
+    return sSTAGE_NAMES[static_cast<std::size_t>(stage)];
+}
+
+void rl::dump_startup_timeline(std::ostream& stream)
+{
+    const auto& timeline = rl::get_startup_timeline();
+    stream << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < rl::startup_stage_count; i++)
+    {
+        stream << std::left << std::setw(16) << sSTAGE_NAMES[i] << std::right << std::setw(10)
+               << get_milliseconds(timeline.stage_begin[i]) << " ms +" << std::setw(10)
+               << get_milliseconds(timeline.stage_end[i] - timeline.stage_begin[i]) << " ms\n";
+    }
+    stream << "time to first frame: ";
+    if (timeline.complete)
+    {
+        stream << get_milliseconds(timeline.time_to_first_frame) << " ms\n";
+    }
+    else
+    {
+        stream << "pending\n";
+    }
+}
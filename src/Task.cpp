@@ -0,0 +1,225 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/Task.hpp>
+#include <rlfw/Timer.hpp>
+#include "Scheduler.hpp"
+#include <array>
+#include <new>
+#include <utility>
+
+namespace
+{
+    // Task frames are recycled through per thread free lists of a few size classes. The lists are
+    // plain pointers so frames freed late during thread exit still have somewhere to go.
+    constexpr std::array<std::size_t, 5> frame_size_classes = {128, 256, 512, 1024, 2048};
+
+    struct FreeFrame
+    {
+        FreeFrame* next;
+    };
+
+    thread_local std::array<FreeFrame*, frame_size_classes.size()> sFREE_FRAMES = {};
+
+    struct FreeFrameReclaimer
+    {
+        ~FreeFrameReclaimer()
+        {
+            for (auto& head : sFREE_FRAMES)
+            {
+                while (head != nullptr)
+                {
+                    auto* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    thread_local FreeFrameReclaimer sFREE_FRAME_RECLAIMER;
+
+    std::size_t get_size_class(std::size_t size) noexcept
+    {
+        std::size_t size_class = 0;
+        while (size_class < frame_size_classes.size() && frame_size_classes[size_class] < size)
+        {
+            size_class++;
+        }
+        return size_class;
+    }
+}
+
+rl::Task rl::Task::promise_type::get_return_object() noexcept
+{
+    return rl::Task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+std::suspend_always rl::Task::promise_type::initial_suspend() noexcept
+{
+    return std::suspend_always();
+}
+
+std::suspend_never rl::Task::promise_type::final_suspend() noexcept
+{
+    return std::suspend_never();
+}
+
+void rl::Task::promise_type::return_void() noexcept
+{
+}
+
+void rl::Task::promise_type::unhandled_exception()
+{
+    // rethrown out of rl::run, like any exception thrown from an App callback
+    throw;
+}
+
+void* rl::Task::promise_type::operator new(std::size_t size)
+{
+    const auto size_class = get_size_class(size);
+    if (size_class == frame_size_classes.size())
+    {
+        return ::operator new(size);
+    }
+    (void)sFREE_FRAME_RECLAIMER;
+    auto& head = sFREE_FRAMES[size_class];
+    if (head == nullptr)
+    {
+        return ::operator new(frame_size_classes[size_class]);
+    }
+    auto* frame = head;
+    head = frame->next;
+    return frame;
+}
+
+void rl::Task::promise_type::operator delete(void* pointer, std::size_t size) noexcept
+{
+    const auto size_class = get_size_class(size);
+    if (size_class == frame_size_classes.size())
+    {
+        ::operator delete(pointer);
+        return;
+    }
+    auto* frame = static_cast<FreeFrame*>(pointer);
+    frame->next = sFREE_FRAMES[size_class];
+    sFREE_FRAMES[size_class] = frame;
+}
+
+rl::Task::Task(std::coroutine_handle<promise_type> handle) noexcept
+    : handle(handle)
+{
+}
+
+rl::Task::Task(Task&& other) noexcept
+    : handle(std::exchange(other.handle, nullptr))
+{
+}
+
+rl::Task::~Task()
+{
+    if (this->handle)
+    {
+        this->handle.destroy();
+    }
+}
+
+bool rl::NextFrameAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+void rl::NextFrameAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    rl::get_scheduler().wait_next_frame(handle);
+}
+
+void rl::NextFrameAwaiter::await_resume() const noexcept
+{
+}
+
+rl::KeyPressedAwaiter::KeyPressedAwaiter(rl::KeyboardKey key) noexcept
+    : key(key)
+{
+}
+
+bool rl::KeyPressedAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+void rl::KeyPressedAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+    rl::get_scheduler().wait_key_pressed(*this);
+}
+
+void rl::KeyPressedAwaiter::await_resume() const noexcept
+{
+}
+
+rl::DelayAwaiter::DelayAwaiter(std::chrono::nanoseconds duration) noexcept
+    : duration(duration)
+{
+}
+
+bool rl::DelayAwaiter::await_ready() const noexcept
+{
+    return this->duration <= std::chrono::nanoseconds::zero();
+}
+
+void rl::DelayAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+    rl::schedule_timer(
+        this->duration,
+        [awaiter = this]
+        {
+            rl::get_scheduler().notify_delayed(*awaiter);
+        });
+    rl::get_scheduler().wait_delayed(*this);
+}
+
+void rl::DelayAwaiter::await_resume() const noexcept
+{
+}
+
+void rl::spawn(rl::Task task)
+{
+    rl::get_scheduler().resume(std::exchange(task.handle, nullptr));
+}
+
+rl::NextFrameAwaiter rl::next_frame() noexcept
+{
+    return rl::NextFrameAwaiter();
+}
+
+rl::KeyPressedAwaiter rl::key_pressed(rl::KeyboardKey key) noexcept
+{
+    return rl::KeyPressedAwaiter(key);
+}
+
+rl::DelayAwaiter rl::delay(std::chrono::nanoseconds duration) noexcept
+{
+    return rl::DelayAwaiter(duration);
+}
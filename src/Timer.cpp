@@ -0,0 +1,62 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/Timer.hpp>
+#include "TimingWheel.hpp"
+#include <utility>
+
+namespace
+{
+    std::uint64_t to_ticks(std::chrono::nanoseconds duration) noexcept
+    {
+        const auto ticks = std::chrono::ceil<std::chrono::milliseconds>(duration).count();
+        return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+    }
+
+    rl::TimerId schedule(std::chrono::nanoseconds delay,
+                         std::uint64_t interval_ticks,
+                         std::function<void()> callback)
+    {
+        auto& wheel = rl::get_timing_wheel();
+        // the wheel only advances once per frame, so delays are measured from the current time
+        const auto now = rl::get_timer_tick();
+        const auto lag = now > wheel.get_tick() ? now - wheel.get_tick() : 0;
+        return wheel.schedule(lag + to_ticks(delay), interval_ticks, std::move(callback));
+    }
+}
+
+rl::TimerId rl::schedule_timer(std::chrono::nanoseconds delay, std::function<void()> callback)
+{
+    return schedule(delay, 0, std::move(callback));
+}
+
+rl::TimerId rl::schedule_repeating_timer(std::chrono::nanoseconds interval,
+                                         std::function<void()> callback)
+{
+    return schedule(interval, std::max<std::uint64_t>(to_ticks(interval), 1), std::move(callback));
+}
+
+bool rl::cancel_timer(rl::TimerId timer)
+{
+    return rl::get_timing_wheel().cancel(timer);
+}
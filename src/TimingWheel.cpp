@@ -0,0 +1,273 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TimingWheel.hpp"
+#include <algorithm>
+#include <utility>
+
+rl::TimerId rl::TimingWheel::schedule(std::uint64_t delay_ticks,
+                                      std::uint64_t interval_ticks,
+                                      std::function<void()> callback)
+{
+    std::uint32_t index;
+    if (!this->free_nodes.empty())
+    {
+        index = this->free_nodes.back();
+        this->free_nodes.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(this->nodes.size());
+        this->nodes.emplace_back();
+    }
+    auto& node = this->nodes[index];
+    node.callback = std::move(callback);
+    node.deadline = this->tick + std::max<std::uint64_t>(delay_ticks, 1);
+    node.interval = interval_ticks;
+    node.state = NodeState::Scheduled;
+    this->link(index);
+    this->timer_count++;
+    return rl::TimerId{index, node.generation};
+}
+
+bool rl::TimingWheel::cancel(rl::TimerId timer)
+{
+    if (timer.index >= this->nodes.size())
+    {
+        return false;
+    }
+    auto& node = this->nodes[timer.index];
+    if (node.generation != timer.generation)
+    {
+        return false;
+    }
+    if (node.state == NodeState::Scheduled)
+    {
+        this->unlink(timer.index);
+        this->release(timer.index);
+        return true;
+    }
+    if (node.state == NodeState::Expired)
+    {
+        // released by run_expired once the batch gets to it
+        node.state = NodeState::Cancelled;
+        return true;
+    }
+    return false;
+}
+
+void rl::TimingWheel::advance(std::uint64_t tick)
+{
+    while (this->tick < tick)
+    {
+        if (this->timer_count == this->expired.size())
+        {
+            // nothing is left in the wheel, so the ticks in between cannot expire anything
+            this->tick = tick;
+            break;
+        }
+        if (this->get_head(0, (this->tick + 1) & (slot_count - 1)) == none)
+        {
+            // jump over ticks that neither expire a timer nor cascade a slot, so catching up
+            // after a long stall costs one step per occupied slot instead of one per tick
+            this->tick = std::min(tick, this->get_next_slot_tick()) - 1;
+        }
+        this->tick++;
+        std::size_t cascade_levels = 1;
+        while (cascade_levels < level_count &&
+               (this->tick & ((std::uint64_t(1) << (level_bits * cascade_levels)) - 1)) == 0)
+        {
+            cascade_levels++;
+        }
+        for (std::size_t level = cascade_levels - 1; level > 0; level--)
+        {
+            this->cascade(level);
+        }
+        auto& head = this->get_head(0, this->tick & (slot_count - 1));
+        while (head != none)
+        {
+            const auto index = head;
+            this->unlink(index);
+            this->nodes[index].state = NodeState::Expired;
+            this->expired.push_back(index);
+        }
+    }
+    this->run_expired();
+}
+
+std::uint64_t rl::TimingWheel::get_tick() const noexcept
+{
+    return this->tick;
+}
+
+std::size_t rl::TimingWheel::get_timer_count() const noexcept
+{
+    return this->timer_count;
+}
+
+std::optional<std::uint64_t> rl::TimingWheel::get_next_tick() const noexcept
+{
+    if (!this->expired.empty())
+    {
+        return this->tick;
+    }
+    if (this->timer_count == 0)
+    {
+        return std::nullopt;
+    }
+    return this->get_next_slot_tick();
+}
+
+std::uint64_t rl::TimingWheel::get_next_slot_tick() const noexcept
+{
+    auto next_tick = UINT64_MAX;
+    for (std::size_t level = 0; level < level_count; level++)
+    {
+        const auto shift = level_bits * level;
+        const auto current = this->tick >> shift;
+        for (std::uint64_t distance = 1; distance <= slot_count; distance++)
+        {
+            const auto slot = (current + distance) & (slot_count - 1);
+            if (this->heads[level * slot_count + slot] != none)
+            {
+                // a level 0 slot expires at this tick, a higher level slot cascades at it
+                next_tick = std::min(next_tick, (current + distance) << shift);
+                break;
+            }
+        }
+    }
+    return next_tick;
+}
+
+std::uint32_t& rl::TimingWheel::get_head(std::size_t level, std::size_t slot) noexcept
+{
+    return this->heads[level * slot_count + slot];
+}
+
+void rl::TimingWheel::link(std::uint32_t index)
+{
+    auto& node = this->nodes[index];
+    const auto delta = node.deadline > this->tick ? node.deadline - this->tick : 0;
+    std::size_t level = 0;
+    while (level + 1 < level_count && delta >= (std::uint64_t(1) << (level_bits * (level + 1))))
+    {
+        level++;
+    }
+    auto target = node.deadline;
+    constexpr auto wheel_span = std::uint64_t(1) << (level_bits * level_count);
+    if (delta >= wheel_span)
+    {
+        // beyond the outermost level, parked in its farthest slot and placed again on cascade
+        target = this->tick + wheel_span - 1;
+    }
+    node.level = static_cast<std::uint8_t>(level);
+    node.slot = static_cast<std::uint8_t>((target >> (level_bits * level)) & (slot_count - 1));
+    auto& head = this->get_head(node.level, node.slot);
+    node.previous = none;
+    node.next = head;
+    if (head != none)
+    {
+        this->nodes[head].previous = index;
+    }
+    head = index;
+}
+
+void rl::TimingWheel::unlink(std::uint32_t index) noexcept
+{
+    auto& node = this->nodes[index];
+    if (node.previous != none)
+    {
+        this->nodes[node.previous].next = node.next;
+    }
+    else
+    {
+        this->get_head(node.level, node.slot) = node.next;
+    }
+    if (node.next != none)
+    {
+        this->nodes[node.next].previous = node.previous;
+    }
+    node.previous = none;
+    node.next = none;
+}
+
+void rl::TimingWheel::cascade(std::size_t level)
+{
+    const auto slot = (this->tick >> (level_bits * level)) & (slot_count - 1);
+    auto index = std::exchange(this->get_head(level, slot), none);
+    while (index != none)
+    {
+        const auto next = this->nodes[index].next;
+        this->link(index);
+        index = next;
+    }
+}
+
+void rl::TimingWheel::release(std::uint32_t index) noexcept
+{
+    auto& node = this->nodes[index];
+    node.callback = nullptr;
+    node.state = NodeState::Free;
+    node.generation = node.generation == UINT32_MAX ? 1 : node.generation + 1;
+    this->free_nodes.push_back(index);
+    this->timer_count--;
+}
+
+void rl::TimingWheel::run_expired()
+{
+    for (std::size_t i = 0; i < this->expired.size(); i++)
+    {
+        const auto index = this->expired[i];
+        if (this->nodes[index].state == NodeState::Cancelled)
+        {
+            this->release(index);
+            continue;
+        }
+        // moved out because callbacks may schedule timers and grow the node storage
+        auto callback = std::move(this->nodes[index].callback);
+        try
+        {
+            callback();
+        }
+        catch (...)
+        {
+            this->expired.erase(this->expired.begin(), this->expired.begin() + i + 1);
+            this->release(index);
+            throw;
+        }
+        auto& node = this->nodes[index];
+        if (node.state == NodeState::Expired && node.interval > 0)
+        {
+            // a repeating timer that fell behind fires once and then keeps its period from now
+            node.callback = std::move(callback);
+            node.deadline = std::max(node.deadline + node.interval, this->tick + 1);
+            node.state = NodeState::Scheduled;
+            this->link(index);
+        }
+        else
+        {
+            this->release(index);
+        }
+    }
+    this->expired.clear();
+}
@@ -0,0 +1,108 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <rlfw/Timer.hpp>
+#include <vector>
+
+namespace rl
+{
+    // A hierarchical timing wheel with five levels of 64 slots and one tick per millisecond.
+    // Timers are nodes of intrusive doubly linked slot lists, so scheduling and cancelling are
+    // constant time. Advancing cascades a higher level slot down whenever the level below wraps,
+    // and expired timers are collected and run as one batch once the wheel is consistent, which
+    // lets callbacks schedule and cancel timers freely.
+    class TimingWheel
+    {
+    public:
+        static constexpr std::size_t level_bits = 6;
+        static constexpr std::size_t slot_count = std::size_t(1) << level_bits;
+        static constexpr std::size_t level_count = 5;
+
+        rl::TimerId schedule(std::uint64_t delay_ticks,
+                             std::uint64_t interval_ticks,
+                             std::function<void()> callback);
+        bool cancel(rl::TimerId timer);
+        void advance(std::uint64_t tick);
+        std::uint64_t get_tick() const noexcept;
+        std::size_t get_timer_count() const noexcept;
+        // A lower bound on the tick the next timer fires at, or nothing when no timer is pending.
+        std::optional<std::uint64_t> get_next_tick() const noexcept;
+
+    private:
+        static constexpr std::uint32_t none = UINT32_MAX;
+
+        enum class NodeState : std::uint8_t
+        {
+            Free,
+            Scheduled,
+            Expired,
+            Cancelled
+        };
+
+        struct Node
+        {
+            std::function<void()> callback;
+            std::uint64_t deadline = 0;
+            std::uint64_t interval = 0;
+            std::uint32_t previous = none;
+            std::uint32_t next = none;
+            std::uint32_t generation = 1;
+            std::uint8_t level = 0;
+            std::uint8_t slot = 0;
+            NodeState state = NodeState::Free;
+        };
+
+        std::uint32_t& get_head(std::size_t level, std::size_t slot) noexcept;
+        void link(std::uint32_t index);
+        void unlink(std::uint32_t index) noexcept;
+        void cascade(std::size_t level);
+        std::uint64_t get_next_slot_tick() const noexcept;
+        void release(std::uint32_t index) noexcept;
+        void run_expired();
+
+        std::vector<Node> nodes;
+        std::vector<std::uint32_t> free_nodes;
+        std::vector<std::uint32_t> expired;
+        std::array<std::uint32_t, level_count * slot_count> heads = make_heads();
+        std::uint64_t tick = 0;
+        std::size_t timer_count = 0;
+
+        static constexpr std::array<std::uint32_t, level_count * slot_count> make_heads() noexcept
+        {
+            std::array<std::uint32_t, level_count * slot_count> heads = {};
+            for (auto& head : heads) head = none;
+            return heads;
+        }
+    };
+
+    // Returns the timing wheel of the running loop, creating it on first use.
+    rl::TimingWheel& get_timing_wheel();
+    // Milliseconds elapsed on the loop's clock since its timing wheel was created.
+    std::uint64_t get_timer_tick();
+}
@@ -0,0 +1,355 @@
+
+// SPDX-FileCopyrightText: 2023 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+    Copyright (c) 2023 Daniel Aimé Valcour
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <rlfw/Watchdog.hpp>
+#include "Watchdog.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#if defined(__linux__) && __has_include(<execinfo.h>)
+#include <csignal>
+#include <cstdlib>
+#include <execinfo.h>
+#include <pthread.h>
+#define RLFW_HAS_STACK_SAMPLING
+#endif
+
+namespace
+{
+    std::int64_t get_now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Written by the loop thread and read by the watchdog. The fields are read one at a time, so
+    // a record may mix values from either side of a phase boundary, which is fine for diagnostics.
+    struct Heartbeat
+    {
+        std::atomic<bool> enabled = false;
+        std::atomic<std::uint64_t> frame = 0;
+        std::atomic<std::int64_t> frame_start = 0;
+        std::atomic<std::int64_t> phase_start = 0;
+        // when the current wait on purpose began, or 0 when the loop is not waiting
+        std::atomic<std::int64_t> idle_start = 0;
+        std::atomic<rl::FramePhase> phase = rl::FramePhase::None;
+        std::atomic<std::uint32_t> event = 0;
+#ifdef RLFW_HAS_STACK_SAMPLING
+        std::atomic<pthread_t> thread = pthread_t();
+#endif
+    };
+
+    Heartbeat sHEARTBEAT;
+
+#ifdef RLFW_HAS_STACK_SAMPLING
+    enum SampleState : int
+    {
+        SAMPLE_IDLE,
+        SAMPLE_REQUESTED,
+        SAMPLE_TAKING,
+        SAMPLE_TAKEN
+    };
+
+    std::atomic<int> sSAMPLE_STATE = SAMPLE_IDLE;
+    std::array<void*, 32> sSAMPLE_STACK;
+    int sSAMPLE_DEPTH = 0;
+
+    void on_sample_signal(int)
+    {
+        int expected = SAMPLE_REQUESTED;
+        if (!sSAMPLE_STATE.compare_exchange_strong(expected, SAMPLE_TAKING))
+        {
+            // a request the watchdog already gave up on
+            return;
+        }
+        sSAMPLE_DEPTH = backtrace(sSAMPLE_STACK.data(), static_cast<int>(sSAMPLE_STACK.size()));
+        sSAMPLE_STATE.store(SAMPLE_TAKEN, std::memory_order_release);
+    }
+
+    void sample_stack(rl::HitchRecord& record)
+    {
+        sSAMPLE_STATE.store(SAMPLE_REQUESTED);
+        if (pthread_kill(sHEARTBEAT.thread.load(), SIGURG) != 0)
+        {
+            sSAMPLE_STATE.store(SAMPLE_IDLE);
+            return;
+        }
+        // a thread blocked in the kernel may not run the handler for a while
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+        while (sSAMPLE_STATE.load(std::memory_order_acquire) != SAMPLE_TAKEN)
+        {
+            int expected = SAMPLE_REQUESTED;
+            if (std::chrono::steady_clock::now() > deadline &&
+                sSAMPLE_STATE.compare_exchange_strong(expected, SAMPLE_IDLE))
+            {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        std::copy_n(sSAMPLE_STACK.begin(), sSAMPLE_DEPTH, record.stack.begin());
+        record.stack_depth = static_cast<std::uint32_t>(sSAMPLE_DEPTH);
+        sSAMPLE_STATE.store(SAMPLE_IDLE);
+    }
+
+    void install_sample_handler()
+    {
+        // the first backtrace loads the unwinder, which is not safe to do inside a signal handler
+        void* frame;
+        backtrace(&frame, 1);
+        struct sigaction action = {};
+        action.sa_handler = on_sample_signal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGURG, &action, nullptr);
+    }
+#endif
+
+    std::mutex sMUTEX;
+    std::condition_variable_any sWAKE;
+    rl::WatchdogSettings sSETTINGS;
+    // a ring holding the last record_capacity records, with sRECORD_COUNT ever written
+    std::vector<rl::HitchRecord> sRECORDS;
+    std::uint64_t sRECORD_COUNT = 0;
+
+    // Called with sMUTEX held.
+    void observe(std::uint64_t& last_frame)
+    {
+        const auto phase = sHEARTBEAT.phase.load(std::memory_order_acquire);
+        if (phase == rl::FramePhase::None || sHEARTBEAT.idle_start.load() != 0)
+        {
+            return;
+        }
+        const auto frame = sHEARTBEAT.frame.load(std::memory_order_relaxed);
+        const auto now = get_now_ns();
+        const auto frame_time =
+            std::chrono::nanoseconds(now - sHEARTBEAT.frame_start.load(std::memory_order_relaxed));
+        if (frame_time < sSETTINGS.frame_budget || sSETTINGS.record_capacity == 0)
+        {
+            return;
+        }
+        sRECORDS.resize(sSETTINGS.record_capacity);
+        const bool same_hitch = sRECORD_COUNT > 0 && last_frame == frame;
+        if (!same_hitch)
+        {
+            sRECORD_COUNT++;
+            last_frame = frame;
+        }
+        auto& record = sRECORDS[(sRECORD_COUNT - 1) % sRECORDS.size()];
+        if (!same_hitch)
+        {
+            record = rl::HitchRecord();
+            record.frame = frame;
+#ifdef RLFW_HAS_STACK_SAMPLING
+            if (sSETTINGS.sample_stack)
+            {
+                sample_stack(record);
+            }
+#endif
+        }
+        // a hitch that is still going is updated in place, so its record shows where it ended up
+        record.phase = phase;
+        record.event = static_cast<rl::EventMask>(sHEARTBEAT.event.load(std::memory_order_relaxed));
+        record.phase_time =
+            std::chrono::nanoseconds(now - sHEARTBEAT.phase_start.load(std::memory_order_relaxed));
+        record.frame_time = frame_time;
+    }
+
+    void watch(std::stop_token stop)
+    {
+        std::uint64_t last_frame = 0;
+        std::unique_lock lock(sMUTEX);
+        while (!stop.stop_requested())
+        {
+            const auto interval = std::clamp<std::chrono::milliseconds>(
+                sSETTINGS.frame_budget / 4,
+                std::chrono::milliseconds(1),
+                std::chrono::milliseconds(50));
+            sWAKE.wait_for(lock, stop, interval, [] { return false; });
+            if (stop.stop_requested())
+            {
+                break;
+            }
+            observe(last_frame);
+        }
+    }
+
+    // declared last, so it is joined before the state it uses is destroyed
+    std::jthread sWATCHDOG_THREAD;
+}
+
+void rl::beat_frame_start(std::uint64_t frame) noexcept
+{
+    if (!sHEARTBEAT.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+#ifdef RLFW_HAS_STACK_SAMPLING
+    sHEARTBEAT.thread.store(pthread_self(), std::memory_order_relaxed);
+#endif
+    sHEARTBEAT.frame.store(frame, std::memory_order_relaxed);
+    sHEARTBEAT.frame_start.store(get_now_ns(), std::memory_order_relaxed);
+}
+
+void rl::beat_phase(rl::FramePhase phase) noexcept
+{
+    if (!sHEARTBEAT.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    sHEARTBEAT.phase_start.store(get_now_ns(), std::memory_order_relaxed);
+    sHEARTBEAT.event.store(0, std::memory_order_relaxed);
+    sHEARTBEAT.phase.store(phase, std::memory_order_release);
+}
+
+void rl::beat_event(std::size_t event_index) noexcept
+{
+    if (!sHEARTBEAT.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    sHEARTBEAT.event.store(1u << event_index, std::memory_order_relaxed);
+}
+
+void rl::beat_idle() noexcept
+{
+    if (!sHEARTBEAT.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    sHEARTBEAT.idle_start.store(get_now_ns());
+}
+
+void rl::beat_resume() noexcept
+{
+    if (!sHEARTBEAT.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    const auto idle_start = sHEARTBEAT.idle_start.exchange(0);
+    if (idle_start == 0)
+    {
+        return;
+    }
+    const auto idle_time = get_now_ns() - idle_start;
+    sHEARTBEAT.frame_start.fetch_add(idle_time, std::memory_order_relaxed);
+    sHEARTBEAT.phase_start.fetch_add(idle_time, std::memory_order_relaxed);
+}
+
+void rl::set_watchdog_settings(const rl::WatchdogSettings& settings)
+{
+    {
+        std::lock_guard lock(sMUTEX);
+        sSETTINGS = settings;
+    }
+    // a frame that is already running is timed from now rather than from a stale start
+    sHEARTBEAT.frame_start.store(get_now_ns());
+    sHEARTBEAT.phase_start.store(get_now_ns());
+    // a wait begun under the old settings is not resumed from, as beats skip it while disabled
+    sHEARTBEAT.idle_start.store(0);
+    sHEARTBEAT.enabled.store(settings.enabled);
+    if (!settings.enabled)
+    {
+        sHEARTBEAT.phase.store(rl::FramePhase::None);
+        // the watchdog needs sMUTEX to notice the stop, so it is joined without holding it
+        sWATCHDOG_THREAD = std::jthread();
+        return;
+    }
+#ifdef RLFW_HAS_STACK_SAMPLING
+    if (settings.sample_stack)
+    {
+        install_sample_handler();
+    }
+#endif
+    if (!sWATCHDOG_THREAD.joinable())
+    {
+        sWATCHDOG_THREAD = std::jthread(watch);
+    }
+}
+
+const rl::WatchdogSettings& rl::get_watchdog_settings()
+{
+    return sSETTINGS;
+}
+
+std::vector<rl::HitchRecord> rl::get_hitch_records()
+{
+    std::lock_guard lock(sMUTEX);
+    std::vector<rl::HitchRecord> records;
+    if (sRECORDS.empty())
+    {
+        return records;
+    }
+    const auto count = std::min<std::uint64_t>(sRECORD_COUNT, sRECORDS.size());
+    for (auto i = sRECORD_COUNT - count; i < sRECORD_COUNT; i++)
+    {
+        records.push_back(sRECORDS[i % sRECORDS.size()]);
+    }
+    return records;
+}
+
+void rl::clear_hitch_records()
+{
+    std::lock_guard lock(sMUTEX);
+    sRECORDS.clear();
+    sRECORD_COUNT = 0;
+}
+
+void rl::dump_hitch_records(std::ostream& stream)
+{
+    for (const auto& record : rl::get_hitch_records())
+    {
+        stream << std::fixed << std::setprecision(3) << "hitch in frame " << record.frame << ": "
+               << std::chrono::duration<double, std::milli>(record.frame_time).count()
+               << " ms in frame, "
+               << std::chrono::duration<double, std::milli>(record.phase_time).count()
+               << " ms in " << rl::get_frame_phase_name(record.phase);
+        if (record.event != rl::EventMask::None)
+        {
+            stream << " handling event mask 0x" << std::hex
+                   << static_cast<std::uint32_t>(record.event) << std::dec;
+        }
+        stream << '\n';
+#ifdef RLFW_HAS_STACK_SAMPLING
+        if (record.stack_depth > 0)
+        {
+            char** symbols =
+                backtrace_symbols(record.stack.data(), static_cast<int>(record.stack_depth));
+            for (std::uint32_t i = 0; i < record.stack_depth; i++)
+            {
+                stream << "    " << (symbols != nullptr ? symbols[i] : "?") << '\n';
+            }
+            std::free(symbols);
+            continue;
+        }
+#endif
+        for (std::uint32_t i = 0; i < record.stack_depth; i++)
+        {
+            stream << "    " << record.stack[i] << '\n';
+        }
+    }
+}
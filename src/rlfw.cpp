@@ -26,9 +26,38 @@
 #include <stdexcept>
 #include <rlm/cellular/cell_vector2.hpp>
 #include "PlatformEvent.hpp"
+#include "EventPump.hpp"
+#include "AllocationTracking.hpp"
+#include "EventArena.hpp"
+#include "InjectionSource.hpp"
+#include "Seqlock.hpp"
+#include "Scheduler.hpp"
+#include "TimingWheel.hpp"
+#include "Watchdog.hpp"
 #include <vector>
 #include <rlfw/App.hpp>
 #include <bitset>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <array>
+#include <variant>
+
+static rl::Seqlock<rl::InputSnapshot> sINPUT_SNAPSHOT;
+
+struct Layer
+{
+    rl::App* app = nullptr;
+    rl::EventMask events = rl::EventMask::All;
+};
 
 struct WindowInfo
 {
@@ -36,19 +65,55 @@ struct WindowInfo
     GLFWwindow* window = nullptr;
     std::string title = "";
     rl::cell_vector2<int> size = rl::cell_vector2<int>(600, 400);
+    rl::cell_vector2<int> settled_size = rl::cell_vector2<int>(600, 400);
+    std::chrono::milliseconds resize_settle_delay = std::chrono::milliseconds(200);
+    rl::TimerId resize_settle_timer = rl::TimerId();
+    rl::vector2<float> content_scale = rl::vector2<float>(1.0f, 1.0f);
     bool visible = true;
     bool resizable = false;
     bool decorated = true;
+    bool show_after_first_frame = false;
+    bool focused = true;
+    bool iconified = false;
+    rl::BackgroundPolicy background_policy = rl::BackgroundPolicy();
+    std::chrono::steady_clock::time_point last_poll = std::chrono::steady_clock::time_point();
     std::vector<rl::PlatformEvent> events;
-    rl::App* app;
+    rl::EventArena event_arena;
+    // bottom to top; the first layer is the app passed to rl::run()
+    std::vector<Layer> layers;
+    // the layers subscribed to each event type, top to bottom, indexed by event.index()
+    std::array<std::vector<rl::App*>, std::variant_size_v<rl::PlatformEvent>> event_layers;
+    bool layers_dirty = false;
+    bool event_consumed = false;
     bool force_close = false;
     bool mouse_entered = false;
     std::bitset<348> keyboard_keys;
     std::bitset<8> mouse_buttons;
     rl::vector2<double> mouse_position = rl::vector2<double>();
+    rl::vector2<double> mouse_scroll = rl::vector2<double>();
+    rl::cell_vector2<int> mouse_cell_size = rl::cell_vector2<int>(1, 1);
+    rl::vector2<double> mouse_cell_origin = rl::vector2<double>();
+    // empty until the first cursor position or cell arrives
+    std::optional<rl::cell_vector2<int>> mouse_cell;
+    bool mouse_cell_dirty = false;
+    std::uint64_t frame = 0;
+    std::unique_ptr<rl::Scheduler> scheduler;
+    std::unique_ptr<rl::TimingWheel> timing_wheel;
+    std::chrono::steady_clock::time_point timer_epoch = std::chrono::steady_clock::time_point();
+    rl::ClockFunction clock = nullptr;
+    bool wait_events = false;
+    std::unique_ptr<rl::InjectionSource> injection_source;
+    rl::FrameStats frame_stats;
+    rl::StartupTimeline startup_timeline;
 };
 
-static WindowInfo sWINDOW_INFO;
+static WindowInfo sMAIN_WINDOW_INFO;
+// The state rl:: functions act on. Headless instances point it at their own while one of their
+// frames runs on a worker thread, and every other thread sees the main window's state.
+static thread_local WindowInfo* sWINDOW_INFO = &sMAIN_WINDOW_INFO;
+// The snapshot of the same context. It is kept out of WindowInfo, which terminate() resets
+// wholesale, so threads reading the main snapshot never touch the main window's state.
+static thread_local rl::Seqlock<rl::InputSnapshot>* sCONTEXT_INPUT_SNAPSHOT = &sINPUT_SNAPSHOT;
 
 void throw_glfw_error()
 {
@@ -57,228 +122,1079 @@ void throw_glfw_error()
     throw std::runtime_error(glfw_error);
 }
 
+// False while a headless instance runs a frame on this thread.
+bool get_is_main_context() noexcept
+{
+    return sWINDOW_INFO == &sMAIN_WINDOW_INFO;
+}
+
 bool is_initialized()
 {
-    return sWINDOW_INFO.window != nullptr;
+    return sWINDOW_INFO->window != nullptr;
 }
 
 void terminate() noexcept
 {
-    if (sWINDOW_INFO.window != nullptr)
+    if (sWINDOW_INFO->window != nullptr)
     {
-        glfwDestroyWindow(sWINDOW_INFO.window);
-        sWINDOW_INFO.window = nullptr;
+        glfwDestroyWindow(sWINDOW_INFO->window);
+        sWINDOW_INFO->window = nullptr;
     }
     glfwTerminate();
-    sWINDOW_INFO = WindowInfo();
+    // the timeline of the run outlives it, so it can still be read once rl::run() returns
+    const auto startup_timeline = sWINDOW_INFO->startup_timeline;
+    *sWINDOW_INFO = WindowInfo();
+    sWINDOW_INFO->startup_timeline = startup_timeline;
+    sINPUT_SNAPSHOT.store(rl::InputSnapshot());
+}
+
+bool get_has_pending_work()
+{
+    return !sWINDOW_INFO->events.empty() ||
+           (sWINDOW_INFO->scheduler && !sWINDOW_INFO->scheduler->get_is_idle()) ||
+           (sWINDOW_INFO->injection_source && sWINDOW_INFO->injection_source->get_has_pending());
+}
+
+// Blocks until a platform event arrives or the next timer is due. Injected events cannot wake the
+// platform's event wait, so while an injection channel is open the wait is kept short.
+void wait_idle()
+{
+    std::optional<std::uint64_t> next_tick;
+    if (sWINDOW_INFO->timing_wheel)
+    {
+        next_tick = sWINDOW_INFO->timing_wheel->get_next_tick();
+    }
+    if (sWINDOW_INFO->injection_source)
+    {
+        const auto injection_tick = rl::get_timer_tick() + 1;
+        next_tick = next_tick ? std::min(*next_tick, injection_tick) : injection_tick;
+    }
+    if (!next_tick)
+    {
+        glfwWaitEvents();
+        return;
+    }
+    const auto now = rl::get_timer_tick();
+    if (*next_tick > now)
+    {
+        glfwWaitEventsTimeout(std::chrono::duration<double>(
+            std::chrono::milliseconds(*next_tick - now)).count());
+    }
+}
+
+// Polls platform events, first sleeping in the platform's event wait for as long as the background
+// policy or an idle loop asks. Events that arrive while waiting are queued for the next dispatch.
+void poll_events()
+{
+    rl::beat_idle();
+    const auto& policy = sWINDOW_INFO->background_policy;
+    double frame_rate = 0.0;
+    bool waited = false;
+    if (policy.enabled && rl::get_window_occluded())
+    {
+        if (policy.pause_update_when_occluded)
+        {
+            glfwWaitEvents();
+            waited = true;
+        }
+        frame_rate = policy.occluded_frame_rate;
+    }
+    else if (policy.enabled && !sWINDOW_INFO->focused)
+    {
+        frame_rate = policy.unfocused_frame_rate;
+    }
+    if (frame_rate > 0.0)
+    {
+        const auto deadline =
+            sWINDOW_INFO->last_poll +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / frame_rate));
+        // an event such as regaining focus ends the wait early, so the frame that handles it
+        // runs at once, and only wakeups that queued nothing keep waiting
+        const auto event_count = sWINDOW_INFO->events.size();
+        for (auto now = std::chrono::steady_clock::now();
+             now < deadline && sWINDOW_INFO->events.size() == event_count;
+             now = std::chrono::steady_clock::now())
+        {
+            glfwWaitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+            waited = true;
+        }
+    }
+    if (!waited && sWINDOW_INFO->wait_events && !get_has_pending_work())
+    {
+        wait_idle();
+    }
+    rl::beat_resume();
+    glfwPollEvents();
+    sWINDOW_INFO->last_poll = std::chrono::steady_clock::now();
+}
+
+void publish_input_snapshot() noexcept
+{
+    rl::InputSnapshot snapshot;
+    snapshot.frame = sWINDOW_INFO->frame;
+    snapshot.keyboard_keys = sWINDOW_INFO->keyboard_keys;
+    snapshot.mouse_buttons = sWINDOW_INFO->mouse_buttons;
+    snapshot.mouse_position = sWINDOW_INFO->mouse_position;
+    snapshot.mouse_cell = sWINDOW_INFO->mouse_cell;
+    snapshot.mouse_scroll = sWINDOW_INFO->mouse_scroll;
+    snapshot.window_size = sWINDOW_INFO->size;
+    snapshot.mouse_entered = sWINDOW_INFO->mouse_entered;
+    snapshot.ctrl_pressed = rl::get_ctrl_pressed();
+    snapshot.alt_pressed = rl::get_alt_pressed();
+    snapshot.shift_pressed = rl::get_shift_pressed();
+    snapshot.super_pressed = rl::get_super_pressed();
+    sCONTEXT_INPUT_SNAPSHOT->store(snapshot);
+}
+
+void rl::push_event(const rl::PlatformEvent& event)
+{
+    sWINDOW_INFO->events.push_back(event);
+}
+
+void rl::push_file_drop_event(int path_count, const char* paths[])
+{
+    rl::FileDropEvent event;
+    event.first_path = sWINDOW_INFO->event_arena.get_string_count();
+    event.path_count = static_cast<std::uint32_t>(path_count);
+    for (int i = 0; i < path_count; i++)
+    {
+        sWINDOW_INFO->event_arena.push_string(paths[i]);
+    }
+    rl::push_event(event);
+}
+
+void rl::push_clipboard_paste_event(std::string_view text)
+{
+    rl::ClipboardPasteEvent event;
+    event.text = sWINDOW_INFO->event_arena.push_string(text);
+    rl::push_event(event);
 }
 
+void rebuild_event_layers()
+{
+    for (std::size_t i = 0; i < sWINDOW_INFO->event_layers.size(); i++)
+    {
+        auto& event_layers = sWINDOW_INFO->event_layers[i];
+        event_layers.clear();
+        for (auto layer = sWINDOW_INFO->layers.rbegin(); layer != sWINDOW_INFO->layers.rend(); layer++)
+        {
+            if ((layer->events & static_cast<rl::EventMask>(1u << i)) != rl::EventMask::None)
+            {
+                event_layers.push_back(layer->app);
+            }
+        }
+    }
+    sWINDOW_INFO->layers_dirty = false;
+}
+
+template<typename Handler>
+void dispatch_to_layers(const rl::PlatformEvent& event_v, Handler&& handler)
+{
+    sWINDOW_INFO->event_consumed = false;
+    for (auto* layer : sWINDOW_INFO->event_layers[event_v.index()])
+    {
+        handler(*layer);
+        if (sWINDOW_INFO->event_consumed)
+        {
+            break;
+        }
+    }
+    sWINDOW_INFO->event_consumed = false;
+}
+
+// Rounds down, saturating at the ends of the int range, which a cursor far outside the window
+// or a tiny cell can exceed.
+int floor_to_cell(double value) noexcept
+{
+    const double cell = std::floor(value);
+    if (!(cell > static_cast<double>(std::numeric_limits<int>::min())))
+    {
+        return std::numeric_limits<int>::min();
+    }
+    if (cell >= static_cast<double>(std::numeric_limits<int>::max()))
+    {
+        return std::numeric_limits<int>::max();
+    }
+    return static_cast<int>(cell);
+}
+
+rl::cell_vector2<int> get_cell_at(const rl::vector2<double>& position) noexcept
+{
+    const auto& size = sWINDOW_INFO->mouse_cell_size;
+    const auto& origin = sWINDOW_INFO->mouse_cell_origin;
+    return rl::cell_vector2<int>(
+        floor_to_cell((position.x - origin.x) / size.x),
+        floor_to_cell((position.y - origin.y) / size.y)
+    );
+}
+
+void dispatch_mouse_cell(const rl::cell_vector2<int>& cell)
+{
+    const auto& current = sWINDOW_INFO->mouse_cell;
+    if (current.has_value() && cell.x == current->x && cell.y == current->y)
+    {
+        return;
+    }
+    if (sWINDOW_INFO->layers_dirty)
+    {
+        rebuild_event_layers();
+    }
+    rl::MouseCellEvent event;
+    event.cell = cell;
+    dispatch_to_layers(
+        event,
+        [&](rl::App& layer)
+        {
+            layer.OnMouseCell(cell);
+        }
+    );
+    sWINDOW_INFO->mouse_cell = cell;
+}
+
+bool rl::dispatch_events()
+{
+    bool should_close = false;
+    bool resized = false;
+    sWINDOW_INFO->event_arena.resolve();
+    sWINDOW_INFO->mouse_scroll = rl::vector2<double>();
+    // events pushed by handlers, such as rl::try_close(), are dispatched in the same batch
+    for (std::size_t i = 0; i < sWINDOW_INFO->events.size(); i++)
+    {
+        const auto event_v = sWINDOW_INFO->events[i];
+        if (get_is_main_context())
+        {
+            rl::beat_event(event_v.index());
+        }
+        if (sWINDOW_INFO->layers_dirty)
+        {
+            rebuild_event_layers();
+        }
+        if (std::holds_alternative<rl::FramebufferSizeEvent>(event_v))
+        {
+            const auto& event = std::get<rl::FramebufferSizeEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnFramebufferSize(event.size);
+                }
+            );
+            sWINDOW_INFO->size = event.size;
+            resized = true;
+        }
+        else if (std::holds_alternative<rl::FramebufferSizeSettledEvent>(event_v))
+        {
+            const auto& event = std::get<rl::FramebufferSizeSettledEvent>(event_v);
+            if (event.size.x != sWINDOW_INFO->settled_size.x ||
+                event.size.y != sWINDOW_INFO->settled_size.y)
+            {
+                dispatch_to_layers(
+                    event_v,
+                    [&](rl::App& layer)
+                    {
+                        layer.OnFramebufferSizeSettled(event.size);
+                    }
+                );
+                sWINDOW_INFO->settled_size = event.size;
+            }
+        }
+        else if (std::holds_alternative<rl::ContentScaleEvent>(event_v))
+        {
+            const auto& event = std::get<rl::ContentScaleEvent>(event_v);
+            if (event.scale.x != sWINDOW_INFO->content_scale.x ||
+                event.scale.y != sWINDOW_INFO->content_scale.y)
+            {
+                dispatch_to_layers(
+                    event_v,
+                    [&](rl::App& layer)
+                    {
+                        layer.OnContentScale(event.scale);
+                    }
+                );
+                sWINDOW_INFO->content_scale = event.scale;
+            }
+        }
+        else if (std::holds_alternative<rl::MouseButtonEvent>(event_v))
+        {
+            const auto& event = std::get<rl::MouseButtonEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnMouseButton(event.mouse_button, event.pressed);
+                }
+            );
+            sWINDOW_INFO->mouse_buttons.set(
+                static_cast<std::size_t>(event.mouse_button),
+                event.pressed
+            );               
+        }
+        else if (std::holds_alternative<rl::MouseEnterEvent>(event_v))
+        {
+            const auto& event = std::get<rl::MouseEnterEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnMouseEnter(event.entered);
+                }
+            );
+            sWINDOW_INFO->mouse_entered = event.entered;
+        }
+        else if (std::holds_alternative<rl::MousePositionEvent>(event_v))
+        {
+            const auto& event = std::get<rl::MousePositionEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnMousePosition(event.position);
+                }
+            );
+            sWINDOW_INFO->mouse_position = event.position;
+            dispatch_mouse_cell(get_cell_at(event.position));
+        }
+        else if (std::holds_alternative<rl::MouseCellEvent>(event_v))
+        {
+            dispatch_mouse_cell(std::get<rl::MouseCellEvent>(event_v).cell);
+        }
+        else if (std::holds_alternative<rl::MouseScrollEvent>(event_v))
+        {
+            const auto& event = std::get<rl::MouseScrollEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnMouseScroll(event.translation);
+                }
+            );
+            sWINDOW_INFO->mouse_scroll.x += event.translation.x;
+            sWINDOW_INFO->mouse_scroll.y += event.translation.y;
+        }
+        else if (std::holds_alternative<rl::KeyboardKeyEvent>(event_v))
+        {
+            const auto& event = std::get<rl::KeyboardKeyEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnKeyboardKey(event.keyboard_key, event.pressed);
+                }
+            );
+            sWINDOW_INFO->keyboard_keys.set(
+                static_cast<std::size_t>(event.keyboard_key) - 1,
+                event.pressed
+            );               
+            if (event.pressed && sWINDOW_INFO->scheduler)
+            {
+                sWINDOW_INFO->scheduler->notify_key_pressed(event.keyboard_key);
+            }
+        }
+        else if (std::holds_alternative<rl::KeyboardCharacterEvent>(event_v))
+        {
+            const auto& event = std::get<rl::KeyboardCharacterEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnKeyboardCharacter(event.codepoint);
+                }
+            );
+        }
+        else if (std::holds_alternative<rl::FileDropEvent>(event_v))
+        {
+            const auto& event = std::get<rl::FileDropEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnFileDrop(sWINDOW_INFO->event_arena.get_strings(event.first_path, event.path_count));
+                }
+            );
+        }
+        else if (std::holds_alternative<rl::ClipboardPasteEvent>(event_v))
+        {
+            const auto& event = std::get<rl::ClipboardPasteEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnClipboardPaste(sWINDOW_INFO->event_arena.get_string(event.text));
+                }
+            );
+        }
+        else if (std::holds_alternative<rl::WindowFocusEvent>(event_v))
+        {
+            const auto& event = std::get<rl::WindowFocusEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnWindowFocus(event.focused);
+                }
+            );
+            sWINDOW_INFO->focused = event.focused;
+        }
+        else if (std::holds_alternative<rl::WindowIconifyEvent>(event_v))
+        {
+            const auto& event = std::get<rl::WindowIconifyEvent>(event_v);
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    layer.OnWindowIconify(event.iconified);
+                }
+            );
+            sWINDOW_INFO->iconified = event.iconified;
+        }
+        else if (std::holds_alternative<rl::WindowCloseEvent>(event_v))
+        {
+            bool close = true;
+            dispatch_to_layers(
+                event_v,
+                [&](rl::App& layer)
+                {
+                    close = layer.OnTryClose() && close;
+                }
+            );
+            should_close = close;
+        }
+    }
+    sWINDOW_INFO->events.clear();
+    sWINDOW_INFO->event_arena.clear();
+    if (sWINDOW_INFO->mouse_cell_dirty)
+    {
+        // the grid changed under a still cursor, if there is a cursor position to map yet
+        sWINDOW_INFO->mouse_cell_dirty = false;
+        if (sWINDOW_INFO->mouse_cell.has_value())
+        {
+            dispatch_mouse_cell(get_cell_at(sWINDOW_INFO->mouse_position));
+        }
+    }
+    if (resized)
+    {
+        // every intermediate size of a drag restarts the quiet period
+        rl::cancel_timer(sWINDOW_INFO->resize_settle_timer);
+        sWINDOW_INFO->resize_settle_timer = rl::schedule_timer(
+            sWINDOW_INFO->resize_settle_delay,
+            []
+            {
+                rl::FramebufferSizeSettledEvent event;
+                event.size = sWINDOW_INFO->size;
+                rl::push_event(event);
+            }
+        );
+    }
+    return should_close;
+}
+
+// Only the main loop is watched by the hitch watchdog.
+void enter_phase(rl::FramePhase phase) noexcept
+{
+    rl::set_allocation_phase(phase);
+    if (get_is_main_context())
+    {
+        rl::beat_phase(phase);
+    }
+}
+
+void update_frame_stats(const rl::AllocationCounters& start) noexcept
+{
+    const auto& end = rl::get_allocation_counters();
+    auto& stats = sWINDOW_INFO->frame_stats;
+    stats.frame = sWINDOW_INFO->frame;
+    stats.allocation_count = 0;
+    stats.allocated_bytes = 0;
+    for (std::size_t i = 0; i < rl::frame_phase_count; i++)
+    {
+        stats.phase_allocation_counts[i] = end.allocation_counts[i] - start.allocation_counts[i];
+        stats.phase_allocated_bytes[i] = end.allocated_bytes[i] - start.allocated_bytes[i];
+        stats.allocation_count += stats.phase_allocation_counts[i];
+        stats.allocated_bytes += stats.phase_allocated_bytes[i];
+    }
+    stats.deallocation_count = end.deallocation_count - start.deallocation_count;
+    stats.hot_allocation_count = end.hot_allocation_count - start.hot_allocation_count;
+}
+
+// Runs the steps of a frame, marking each phase as it is entered.
+bool run_frame_phases()
+{
+    if (get_is_main_context())
+    {
+        rl::beat_frame_start(sWINDOW_INFO->frame + 1);
+    }
+    enter_phase(rl::FramePhase::FrameStart);
+    // indexed, as a handler may push or pop layers
+    for (std::size_t i = 0; i < sWINDOW_INFO->layers.size(); i++)
+    {
+        sWINDOW_INFO->layers[i].app->OnFrameStart();
+    }
+    enter_phase(rl::FramePhase::Poll);
+    if (is_initialized())
+    {
+        poll_events();
+    }
+    if (sWINDOW_INFO->injection_source)
+    {
+        sWINDOW_INFO->injection_source->drain(sWINDOW_INFO->events);
+    }
+    enter_phase(rl::FramePhase::Dispatch);
+    const bool should_close = rl::dispatch_events();
+    sWINDOW_INFO->frame++;
+    publish_input_snapshot();
+    const auto& policy = sWINDOW_INFO->background_policy;
+    const bool occluded = policy.enabled && rl::get_window_occluded();
+    if (occluded && policy.pause_update_when_occluded)
+    {
+        return should_close;
+    }
+    enter_phase(rl::FramePhase::Timers);
+    if (sWINDOW_INFO->timing_wheel)
+    {
+        sWINDOW_INFO->timing_wheel->advance(rl::get_timer_tick());
+    }
+    enter_phase(rl::FramePhase::Tasks);
+    if (sWINDOW_INFO->scheduler)
+    {
+        sWINDOW_INFO->scheduler->update();
+    }
+    enter_phase(rl::FramePhase::Update);
+    for (std::size_t i = 0; i < sWINDOW_INFO->layers.size(); i++)
+    {
+        sWINDOW_INFO->layers[i].app->OnUpdate();
+    }
+    if (!occluded || !policy.skip_draw_when_occluded)
+    {
+        // dispatch draw thread
+        enter_phase(rl::FramePhase::Draw);
+        for (std::size_t i = 0; i < sWINDOW_INFO->layers.size(); i++)
+        {
+            sWINDOW_INFO->layers[i].app->OnPostDraw();
+        }
+    }
+    return should_close;
+}
+
+bool rl::run_frame()
+{
+    const auto start_counters = rl::get_allocation_counters();
+    bool should_close = false;
+    try
+    {
+        should_close = run_frame_phases();
+    }
+    catch (...)
+    {
+        enter_phase(rl::FramePhase::None);
+        throw;
+    }
+    enter_phase(rl::FramePhase::None);
+    update_frame_stats(start_counters);
+    return should_close;
+}
+
+// suspended tasks are destroyed while the app they may refer to is still intact, and before the
+// timers their frames may still cancel
+void stop(rl::App& app)
+{
+    sWINDOW_INFO->scheduler.reset();
+    sWINDOW_INFO->timing_wheel.reset();
+    app.OnAppStop();
+}
+
+// Records the stages of rl::run() into a timeline as offsets from the recorder's creation. Distinct
+// stages may be recorded from different threads.
+class StartupRecorder
+{
+public:
+    explicit StartupRecorder(rl::StartupTimeline& timeline) :
+        timeline(timeline),
+        origin(std::chrono::steady_clock::now())
+    {
+        this->timeline = rl::StartupTimeline();
+    }
+
+    void begin(rl::StartupStage stage) noexcept
+    {
+        this->timeline.stage_begin[static_cast<std::size_t>(stage)] = this->get_elapsed();
+    }
+
+    void end(rl::StartupStage stage) noexcept
+    {
+        this->timeline.stage_end[static_cast<std::size_t>(stage)] = this->get_elapsed();
+    }
+
+    void complete() noexcept
+    {
+        this->timeline.time_to_first_frame = this->get_elapsed();
+        this->timeline.complete = true;
+    }
+
+private:
+    std::chrono::nanoseconds get_elapsed() const noexcept
+    {
+        return std::chrono::steady_clock::now() - this->origin;
+    }
+
+    rl::StartupTimeline& timeline;
+    std::chrono::steady_clock::time_point origin;
+};
+
 void rl::run(rl::App& app)
 {
     if (rl::get_is_running())
     {
         throw std::runtime_error("rlfw is already running");
     }
-    sWINDOW_INFO.is_running = true;
+    StartupRecorder startup(sWINDOW_INFO->startup_timeline);
+    sWINDOW_INFO->is_running = true;
+    rl::push_layer(app);
+    startup.begin(rl::StartupStage::AppStart);
     app.OnAppStart();
+    startup.end(rl::StartupStage::AppStart);
+    // Prefetching overlaps the platform and context setup below, which must stay on this thread.
+    // The exception is declared first so it outlives the worker, which is joined on every path.
+    std::exception_ptr prefetch_exception;
+    std::jthread prefetch_thread(
+        [&]()
+        {
+            startup.begin(rl::StartupStage::Prefetch);
+            try
+            {
+                app.OnPrefetchResources();
+            }
+            catch (...)
+            {
+                prefetch_exception = std::current_exception();
+            }
+            startup.end(rl::StartupStage::Prefetch);
+        }
+    );
+    startup.begin(rl::StartupStage::PlatformInit);
     if (!glfwInit())
     {
         throw_glfw_error();
     }
+    startup.end(rl::StartupStage::PlatformInit);
+    startup.begin(rl::StartupStage::WindowCreation);
     glfwDefaultWindowHints();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
 #endif
-    glfwWindowHint(GLFW_VISIBLE, sWINDOW_INFO.visible);
-    glfwWindowHint(GLFW_RESIZABLE, sWINDOW_INFO.resizable);
-    glfwWindowHint(GLFW_DECORATED, sWINDOW_INFO.decorated);
-    sWINDOW_INFO.window = glfwCreateWindow(sWINDOW_INFO.size.x, sWINDOW_INFO.size.y, sWINDOW_INFO.title.data(), NULL, NULL);
-    if (!sWINDOW_INFO.window)
+    glfwWindowHint(
+        GLFW_VISIBLE,
+        sWINDOW_INFO->visible && !sWINDOW_INFO->show_after_first_frame
+    );
+    glfwWindowHint(GLFW_RESIZABLE, sWINDOW_INFO->resizable);
+    glfwWindowHint(GLFW_DECORATED, sWINDOW_INFO->decorated);
+    sWINDOW_INFO->window = glfwCreateWindow(sWINDOW_INFO->size.x, sWINDOW_INFO->size.y, sWINDOW_INFO->title.data(), NULL, NULL);
+    if (!sWINDOW_INFO->window)
     {
         glfwTerminate();
         throw_glfw_error();
     }
-    glfwMakeContextCurrent(sWINDOW_INFO.window);
+    glfwMakeContextCurrent(sWINDOW_INFO->window);
+    sWINDOW_INFO->focused = glfwGetWindowAttrib(sWINDOW_INFO->window, GLFW_FOCUSED);
+    sWINDOW_INFO->iconified = glfwGetWindowAttrib(sWINDOW_INFO->window, GLFW_ICONIFIED);
+    glfwGetWindowContentScale(
+        sWINDOW_INFO->window,
+        &sWINDOW_INFO->content_scale.x,
+        &sWINDOW_INFO->content_scale.y
+    );
+    sWINDOW_INFO->settled_size = sWINDOW_INFO->size;
+    startup.end(rl::StartupStage::WindowCreation);
+    startup.begin(rl::StartupStage::PrefetchWait);
+    prefetch_thread.join();
+    startup.end(rl::StartupStage::PrefetchWait);
+    if (prefetch_exception)
+    {
+        std::rethrow_exception(prefetch_exception);
+    }
+    startup.begin(rl::StartupStage::LoadResources);
     app.OnLoadResources();
+    startup.end(rl::StartupStage::LoadResources);
+    startup.begin(rl::StartupStage::CallbackSetup);
     glfwSetFramebufferSizeCallback(
-      sWINDOW_INFO.window,
+      sWINDOW_INFO->window,
       [](GLFWwindow* window, int width, int height)
       {
         rl::FramebufferSizeEvent event;
         event.size = rl::cell_vector2<int>(width, height);
-        sWINDOW_INFO.events.push_back(event);
+        rl::push_event(event);
+      }
+    );
+    glfwSetWindowContentScaleCallback(
+      sWINDOW_INFO->window,
+      [](GLFWwindow* window, float x_scale, float y_scale)
+      {
+        rl::ContentScaleEvent event;
+        event.scale = rl::vector2<float>(x_scale, y_scale);
+        rl::push_event(event);
       }
     );
     glfwSetMouseButtonCallback(
-      sWINDOW_INFO.window,
+      sWINDOW_INFO->window,
       [](GLFWwindow* window, int button, int action, int mods)
       {
         rl::MouseButtonEvent event;
         event.mouse_button = static_cast<rl::MouseButton>(button);
         event.pressed = action;
-        sWINDOW_INFO.events.push_back(event);
+        rl::push_event(event);
       }
     );
     glfwSetCursorPosCallback(
-      sWINDOW_INFO.window,
+      sWINDOW_INFO->window,
       [](GLFWwindow* window, double xpos, double ypos)
       {
         rl::MousePositionEvent event;
         event.position = rl::vector2<double>(xpos, ypos);
-        sWINDOW_INFO.events.push_back(event);
+        rl::push_event(event);
       }
     );
     glfwSetCursorEnterCallback(
-      sWINDOW_INFO.window,
+      sWINDOW_INFO->window,
       [](GLFWwindow* window, int entered)
       {
         rl::MouseEnterEvent event;
         event.entered = entered;
-        sWINDOW_INFO.events.push_back(event);
+        rl::push_event(event);
       }
     );
     glfwSetScrollCallback(
-        sWINDOW_INFO.window,
+        sWINDOW_INFO->window,
         [](GLFWwindow* window, double x_translation, double y_translation)
         {
             rl::MouseScrollEvent event;
             event.translation = rl::vector2<double>(x_translation, y_translation);
-            sWINDOW_INFO.events.push_back(event);
+            rl::push_event(event);
         }
     );
     glfwSetKeyCallback(
-        sWINDOW_INFO.window,
+        sWINDOW_INFO->window,
         [](GLFWwindow* window, int key, int scancode, int action, int mods)
         {
             rl::KeyboardKeyEvent event;
             event.keyboard_key = static_cast<rl::KeyboardKey>(key);
             event.pressed = action;
-            sWINDOW_INFO.events.push_back(event);
+            rl::push_event(event);
+#ifdef __APPLE__
+            const int paste_modifier = GLFW_MOD_SUPER;
+#else
+            const int paste_modifier = GLFW_MOD_CONTROL;
+#endif
+            const bool paste =
+                action != GLFW_RELEASE &&
+                ((key == GLFW_KEY_V && mods == paste_modifier) ||
+                (key == GLFW_KEY_INSERT && mods == GLFW_MOD_SHIFT));
+            if (paste)
+            {
+                const char* text = glfwGetClipboardString(window);
+                if (text != nullptr)
+                {
+                    rl::push_clipboard_paste_event(text);
+                }
+            }
         }
     );
     glfwSetCharCallback(
-        sWINDOW_INFO.window,
+        sWINDOW_INFO->window,
         [](GLFWwindow* window, unsigned int codepoint)
         {
             rl::KeyboardCharacterEvent event;
             event.codepoint = codepoint;
-            sWINDOW_INFO.events.push_back(event);
+            rl::push_event(event);
+        }
+    );
+    glfwSetDropCallback(
+        sWINDOW_INFO->window,
+        [](GLFWwindow* window, int path_count, const char* paths[])
+        {
+            rl::push_file_drop_event(path_count, paths);
+        }
+    );
+    glfwSetWindowFocusCallback(
+        sWINDOW_INFO->window,
+        [](GLFWwindow* window, int focused)
+        {
+            rl::WindowFocusEvent event;
+            event.focused = focused;
+            rl::push_event(event);
+        }
+    );
+    glfwSetWindowIconifyCallback(
+        sWINDOW_INFO->window,
+        [](GLFWwindow* window, int iconified)
+        {
+            rl::WindowIconifyEvent event;
+            event.iconified = iconified;
+            rl::push_event(event);
         }
     );
     glfwSetWindowCloseCallback(
-        sWINDOW_INFO.window,
+        sWINDOW_INFO->window,
         [](GLFWwindow* window)
         {
             rl::WindowCloseEvent event;
-            sWINDOW_INFO.events.push_back(event);
+            rl::push_event(event);
         }
     );
-    sWINDOW_INFO.force_close = false;
-    bool should_close = false;
-    while (!should_close && !sWINDOW_INFO.force_close)
+    startup.end(rl::StartupStage::CallbackSetup);
+    sWINDOW_INFO->force_close = false;
+    startup.begin(rl::StartupStage::FirstFrame);
+    bool should_close = rl::run_frame();
+    if (sWINDOW_INFO->show_after_first_frame && sWINDOW_INFO->visible && !should_close)
     {
-        app.OnFrameStart();
-        glfwPollEvents();
-        for (const auto& event_v : sWINDOW_INFO.events)
+        glfwShowWindow(sWINDOW_INFO->window);
+    }
+    startup.end(rl::StartupStage::FirstFrame);
+    startup.complete();
+    while (!should_close && !sWINDOW_INFO->force_close)
+    {
+        should_close = rl::run_frame();
+    }
+    stop(app);
+    terminate();
+}
+
+// A headless instance owns its state outright. Instances are aligned to cache lines so the ones
+// that run on different workers never share one.
+struct alignas(64) HeadlessInstance
+{
+    WindowInfo window_info;
+    rl::Seqlock<rl::InputSnapshot> input_snapshot;
+    rl::App* app = nullptr;
+    bool started = false;
+    bool stopped = false;
+    std::exception_ptr exception;
+};
+
+// Runs one frame of a headless instance on the calling thread, starting it on its first frame
+// and stopping it on its last. Returns true once the instance has stopped. The thread's context
+// and allocation phase are restored afterwards, as it may be in the middle of a frame of its own
+// when rl::run_headless() is called from a handler.
+bool run_headless_frame(HeadlessInstance& instance) noexcept
+{
+    WindowInfo* const previous_window_info = sWINDOW_INFO;
+    auto* const previous_input_snapshot = sCONTEXT_INPUT_SNAPSHOT;
+    const rl::FramePhase previous_phase = rl::get_allocation_phase();
+    sWINDOW_INFO = &instance.window_info;
+    sCONTEXT_INPUT_SNAPSHOT = &instance.input_snapshot;
+    try
+    {
+        if (!instance.started)
         {
-            if (std::holds_alternative<rl::FramebufferSizeEvent>(event_v))
-            {
-                const auto& event = std::get<rl::FramebufferSizeEvent>(event_v);
-                app.OnFramebufferSize(event.size);
-                sWINDOW_INFO.size = event.size;
-            }
-            else if (std::holds_alternative<rl::MouseButtonEvent>(event_v))
-            {
-                const auto& event = std::get<rl::MouseButtonEvent>(event_v);
-                app.OnMouseButton(event.mouse_button, event.pressed);
-                sWINDOW_INFO.mouse_buttons.set(
-                    static_cast<std::size_t>(event.mouse_button),
-                    event.pressed
-                );               
-            }
-            else if (std::holds_alternative<rl::MouseEnterEvent>(event_v))
-            {
-                const auto& event = std::get<rl::MouseEnterEvent>(event_v);
-                app.OnMouseEnter(event.entered);
-                sWINDOW_INFO.mouse_entered = event.entered;
-            }
-            else if (std::holds_alternative<rl::MousePositionEvent>(event_v))
-            {
-                const auto& event = std::get<rl::MousePositionEvent>(event_v);
-                app.OnMousePosition(event.position);
-                sWINDOW_INFO.mouse_position = event.position;
-            }
-            else if (std::holds_alternative<rl::MouseScrollEvent>(event_v))
-            {
-                const auto& event = std::get<rl::MouseScrollEvent>(event_v);
-                app.OnMouseScroll(event.translation);
-            }
-            else if (std::holds_alternative<rl::KeyboardKeyEvent>(event_v))
+            instance.started = true;
+            instance.app->OnAppStart();
+            instance.app->OnPrefetchResources();
+            instance.app->OnLoadResources();
+        }
+        if (rl::run_frame() || sWINDOW_INFO->force_close)
+        {
+            instance.stopped = true;
+            stop(*instance.app);
+        }
+    }
+    catch (...)
+    {
+        instance.exception = std::current_exception();
+        instance.stopped = true;
+        // tasks and timers of a failed instance are still torn down in its own context
+        sWINDOW_INFO->scheduler.reset();
+        sWINDOW_INFO->timing_wheel.reset();
+    }
+    sWINDOW_INFO = previous_window_info;
+    sCONTEXT_INPUT_SNAPSHOT = previous_input_snapshot;
+    rl::set_allocation_phase(previous_phase);
+    return instance.stopped;
+}
+
+void rl::run_headless(std::span<rl::App* const> apps, std::size_t thread_count)
+{
+    std::vector<std::unique_ptr<HeadlessInstance>> instances;
+    instances.reserve(apps.size());
+    for (auto* app : apps)
+    {
+        auto instance = std::make_unique<HeadlessInstance>();
+        instance->window_info.is_running = true;
+        instance->app = app;
+        Layer layer;
+        layer.app = app;
+        instance->window_info.layers.push_back(layer);
+        instance->window_info.layers_dirty = true;
+        instances.push_back(std::move(instance));
+    }
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min(thread_count, std::max<std::size_t>(1, instances.size()));
+    // Each live instance is either queued or running one frame on a worker, which queues it again
+    // afterwards, so instances never wait on each other and a slow one only occupies one thread.
+    std::mutex queue_mutex;
+    std::condition_variable queue_changed;
+    std::deque<HeadlessInstance*> runnable;
+    for (const auto& instance : instances)
+    {
+        runnable.push_back(instance.get());
+    }
+    std::size_t live_count = instances.size();
+    const auto work = [&]
+    {
+        std::unique_lock lock(queue_mutex);
+        while (true)
+        {
+            queue_changed.wait(
+                lock,
+                [&]()
+                {
+                    return !runnable.empty() || live_count == 0;
+                }
+            );
+            if (live_count == 0)
             {
-                const auto& event = std::get<rl::KeyboardKeyEvent>(event_v);
-                app.OnKeyboardKey(event.keyboard_key, event.pressed);
-                sWINDOW_INFO.keyboard_keys.set(
-                    static_cast<std::size_t>(event.keyboard_key) - 1,
-                    event.pressed
-                );               
+                return;
             }
-            else if (std::holds_alternative<rl::KeyboardCharacterEvent>(event_v))
+            auto* instance = runnable.front();
+            runnable.pop_front();
+            lock.unlock();
+            const bool stopped = run_headless_frame(*instance);
+            lock.lock();
+            if (!stopped)
             {
-                const auto& event = std::get<rl::KeyboardCharacterEvent>(event_v);
-                app.OnKeyboardCharacter(event.codepoint);
+                runnable.push_back(instance);
+                queue_changed.notify_one();
             }
-            else if (std::holds_alternative<rl::WindowCloseEvent>(event_v))
+            else if (--live_count == 0)
             {
-                should_close = app.OnTryClose();
+                queue_changed.notify_all();
             }
         }
-        sWINDOW_INFO.events.clear();
-        app.OnUpdate();
-        // dispatch draw thread
-        app.OnPostDraw();
+    };
+    std::vector<std::jthread> workers;
+    workers.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; i++)
+    {
+        workers.emplace_back(work);
     }
-    app.OnAppStop();
-    terminate();
+    work();
+    workers.clear();
+    for (const auto& instance : instances)
+    {
+        if (instance->exception)
+        {
+            std::rethrow_exception(instance->exception);
+        }
+    }
+}
+
+rl::Scheduler& rl::get_scheduler()
+{
+    if (!sWINDOW_INFO->scheduler)
+    {
+        sWINDOW_INFO->scheduler = std::make_unique<rl::Scheduler>();
+    }
+    return *sWINDOW_INFO->scheduler;
+}
+
+rl::TimingWheel& rl::get_timing_wheel()
+{
+    if (!sWINDOW_INFO->timing_wheel)
+    {
+        sWINDOW_INFO->timing_wheel = std::make_unique<rl::TimingWheel>();
+        sWINDOW_INFO->timer_epoch = rl::get_time();
+    }
+    return *sWINDOW_INFO->timing_wheel;
+}
+
+std::uint64_t rl::get_timer_tick()
+{
+    const auto elapsed = rl::get_time() - sWINDOW_INFO->timer_epoch;
+    const auto ticks = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+}
+
+void rl::set_clock(rl::ClockFunction clock)
+{
+    if (!sWINDOW_INFO->timing_wheel)
+    {
+        sWINDOW_INFO->clock = clock;
+        return;
+    }
+    // the epoch moves onto the new clock, so the tick carries over and pending timers neither
+    // stall nor fire at once
+    const auto elapsed = rl::get_time() - sWINDOW_INFO->timer_epoch;
+    sWINDOW_INFO->clock = clock;
+    sWINDOW_INFO->timer_epoch = rl::get_time() - elapsed;
+}
+
+std::chrono::steady_clock::time_point rl::get_time()
+{
+    return sWINDOW_INFO->clock != nullptr ? sWINDOW_INFO->clock() : std::chrono::steady_clock::now();
 }
 
 bool rl::get_is_running() noexcept
 {
-    return sWINDOW_INFO.is_running;
+    return sWINDOW_INFO->is_running;
 }
 
 void rl::try_close()
 {
-    sWINDOW_INFO.events.push_back(rl::WindowCloseEvent());
+    rl::push_event(rl::WindowCloseEvent());
 }
 
 void rl::force_close()
 {
-    sWINDOW_INFO.force_close = true;
+    sWINDOW_INFO->force_close = true;
+}
+
+void rl::push_layer(rl::App& layer, rl::EventMask events)
+{
+    Layer new_layer;
+    new_layer.app = &layer;
+    new_layer.events = events;
+    sWINDOW_INFO->layers.push_back(new_layer);
+    sWINDOW_INFO->layers_dirty = true;
+}
+
+void rl::pop_layer()
+{
+    if (sWINDOW_INFO->layers.empty())
+    {
+        throw std::runtime_error("there is no layer to pop");
+    }
+    sWINDOW_INFO->layers.pop_back();
+    sWINDOW_INFO->layers_dirty = true;
+}
+
+void rl::consume_event() noexcept
+{
+    sWINDOW_INFO->event_consumed = true;
 }
 
 std::string_view rl::get_window_title()
 {
-    return sWINDOW_INFO.title;
+    return sWINDOW_INFO->title;
 }
 
 void rl::set_window_title(std::string_view title)
 {
     if (is_initialized())
     {
-        glfwSetWindowTitle(sWINDOW_INFO.window, title.data());
+        glfwSetWindowTitle(sWINDOW_INFO->window, title.data());
     }
-    sWINDOW_INFO.title = title;
+    sWINDOW_INFO->title = title;
 }
 
 void rl::set_window_size(const rl::cell_vector2<int>& size)
 {
     if (is_initialized())
     {
-        glfwSetWindowSize(sWINDOW_INFO.window, size.x, size.y);
+        glfwSetWindowSize(sWINDOW_INFO->window, size.x, size.y);
     }
-    sWINDOW_INFO.size = size;
+    sWINDOW_INFO->size = size;
 }
 
 void rl::set_window_size(int width, int height)
@@ -288,7 +1204,22 @@ void rl::set_window_size(int width, int height)
 
 rl::cell_vector2<int> rl::get_window_size()
 {
-    return sWINDOW_INFO.size;
+    return sWINDOW_INFO->size;
+}
+
+void rl::set_resize_settle_delay(std::chrono::milliseconds delay)
+{
+    sWINDOW_INFO->resize_settle_delay = delay;
+}
+
+std::chrono::milliseconds rl::get_resize_settle_delay()
+{
+    return sWINDOW_INFO->resize_settle_delay;
+}
+
+rl::vector2<float> rl::get_content_scale()
+{
+    return sWINDOW_INFO->content_scale;
 }
 
 void rl::set_window_visible(bool visible)
@@ -297,62 +1228,194 @@ void rl::set_window_visible(bool visible)
     {
         if (visible)
         {
-            glfwShowWindow(sWINDOW_INFO.window);
+            glfwShowWindow(sWINDOW_INFO->window);
         }
         else
         {
-            glfwHideWindow(sWINDOW_INFO.window);
+            glfwHideWindow(sWINDOW_INFO->window);
         }
     }
-    sWINDOW_INFO.visible = visible;
+    sWINDOW_INFO->visible = visible;
 }
 
 bool rl::get_window_visible()
 {
-    return sWINDOW_INFO.visible;
+    return sWINDOW_INFO->visible;
+}
+
+void rl::set_show_window_after_first_frame(bool show_after_first_frame)
+{
+    sWINDOW_INFO->show_after_first_frame = show_after_first_frame;
+}
+
+bool rl::get_show_window_after_first_frame()
+{
+    return sWINDOW_INFO->show_after_first_frame;
 }
 
 void rl::set_window_resizable(bool resizable)
 {
     if (is_initialized())
     {
-        glfwSetWindowAttrib(sWINDOW_INFO.window, GLFW_RESIZABLE, resizable);
+        glfwSetWindowAttrib(sWINDOW_INFO->window, GLFW_RESIZABLE, resizable);
     }
-    sWINDOW_INFO.resizable = resizable;
+    sWINDOW_INFO->resizable = resizable;
 }
 
 bool rl::get_window_resizable()
 {
-    return sWINDOW_INFO.resizable;
+    return sWINDOW_INFO->resizable;
 }
 
 void rl::set_window_decorated(bool decorated)
 {
     if (is_initialized())
     {
-        glfwSetWindowAttrib(sWINDOW_INFO.window, GLFW_DECORATED, decorated);
+        glfwSetWindowAttrib(sWINDOW_INFO->window, GLFW_DECORATED, decorated);
     }
-    sWINDOW_INFO.decorated = decorated; 
+    sWINDOW_INFO->decorated = decorated; 
 }
 
 bool rl::get_window_decorated()
 {
-    return sWINDOW_INFO.decorated;
+    return sWINDOW_INFO->decorated;
+}
+
+bool rl::get_window_focused()
+{
+    return sWINDOW_INFO->focused;
+}
+
+bool rl::get_window_iconified()
+{
+    return sWINDOW_INFO->iconified;
+}
+
+bool rl::get_window_occluded()
+{
+    return sWINDOW_INFO->iconified || sWINDOW_INFO->size.x <= 0 || sWINDOW_INFO->size.y <= 0;
+}
+
+void rl::set_wait_events(bool wait_events)
+{
+    sWINDOW_INFO->wait_events = wait_events;
+}
+
+bool rl::get_wait_events()
+{
+    return sWINDOW_INFO->wait_events;
+}
+
+void rl::set_background_policy(const rl::BackgroundPolicy& policy)
+{
+    sWINDOW_INFO->background_policy = policy;
+}
+
+const rl::BackgroundPolicy& rl::get_background_policy()
+{
+    return sWINDOW_INFO->background_policy;
+}
+
+std::string_view rl::get_clipboard()
+{
+    if (!is_initialized())
+    {
+        return std::string_view();
+    }
+    const char* text = glfwGetClipboardString(sWINDOW_INFO->window);
+    return text != nullptr ? std::string_view(text) : std::string_view();
+}
+
+void rl::set_clipboard(std::string_view text)
+{
+    if (is_initialized())
+    {
+        glfwSetClipboardString(sWINDOW_INFO->window, std::string(text).c_str());
+    }
 }
 
 bool rl::get_mouse_entered()
 {
-    return sWINDOW_INFO.mouse_entered;
+    return sWINDOW_INFO->mouse_entered;
+}
+
+void rl::set_input_injection_channel(std::string_view channel)
+{
+    if (channel == rl::get_input_injection_channel())
+    {
+        return;
+    }
+    std::unique_ptr<rl::InjectionSource> source;
+    if (!channel.empty())
+    {
+        source = std::make_unique<rl::InjectionSource>(channel);
+    }
+    sWINDOW_INFO->injection_source = std::move(source);
+}
+
+std::string_view rl::get_input_injection_channel()
+{
+    if (!sWINDOW_INFO->injection_source)
+    {
+        return std::string_view();
+    }
+    return sWINDOW_INFO->injection_source->get_channel();
+}
+
+void rl::set_mouse_cell_size(const rl::cell_vector2<int>& size)
+{
+    if (size.x <= 0 || size.y <= 0)
+    {
+        throw std::runtime_error("mouse cell size must be positive");
+    }
+    sWINDOW_INFO->mouse_cell_size = size;
+    sWINDOW_INFO->mouse_cell_dirty = true;
+}
+
+rl::cell_vector2<int> rl::get_mouse_cell_size()
+{
+    return sWINDOW_INFO->mouse_cell_size;
+}
+
+void rl::set_mouse_cell_origin(const rl::vector2<double>& origin)
+{
+    sWINDOW_INFO->mouse_cell_origin = origin;
+    sWINDOW_INFO->mouse_cell_dirty = true;
+}
+
+rl::vector2<double> rl::get_mouse_cell_origin()
+{
+    return sWINDOW_INFO->mouse_cell_origin;
+}
+
+std::optional<rl::cell_vector2<int>> rl::get_mouse_cell()
+{
+    return sWINDOW_INFO->mouse_cell;
 }
 
 bool rl::get_pressed(rl::MouseButton button)
 {
-    return sWINDOW_INFO.mouse_buttons.test(static_cast<std::size_t>(button));
+    return sWINDOW_INFO->mouse_buttons.test(static_cast<std::size_t>(button));
 }
 
 bool rl::get_pressed(rl::KeyboardKey key)
 {
-    return sWINDOW_INFO.keyboard_keys.test(static_cast<std::size_t>(key) - 1);
+    return sWINDOW_INFO->keyboard_keys.test(static_cast<std::size_t>(key) - 1);
+}
+
+const rl::FrameStats& rl::get_frame_stats() noexcept
+{
+    return sWINDOW_INFO->frame_stats;
+}
+
+const rl::StartupTimeline& rl::get_startup_timeline() noexcept
+{
+    return sWINDOW_INFO->startup_timeline;
+}
+
+rl::InputSnapshot rl::get_input_snapshot() noexcept
+{
+    return sCONTEXT_INPUT_SNAPSHOT->load();
 }
 
 bool rl::get_ctrl_pressed()